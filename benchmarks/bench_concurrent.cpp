@@ -0,0 +1,62 @@
+#include "vectormap.hpp"
+#include "concurrent_vectormap.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+// Readers looking up keys while one of the threads rewrites a value every 1024 lookups.
+constexpr uint64_t size = 1024;
+constexpr uint64_t write_every = 1024;
+
+// The usual wrapper: every access takes the mutex.
+struct mutex_map {
+    com::vectormap<uint64_t, uint64_t> map;
+    mutable std::mutex mutex;
+
+    uint64_t get_value(uint64_t key) const { std::lock_guard<std::mutex> lock(mutex); return map.get_value(key).at(0); }
+    void set_value(uint64_t value, uint64_t key) { std::lock_guard<std::mutex> lock(mutex); map.set_value(value, key); }
+};
+
+struct shared_mutex_map {
+    com::vectormap<uint64_t, uint64_t> map;
+    mutable std::shared_mutex mutex;
+
+    uint64_t get_value(uint64_t key) const { std::shared_lock<std::shared_mutex> lock(mutex); return map.get_value(key).at(0); }
+    void set_value(uint64_t value, uint64_t key) { std::unique_lock<std::shared_mutex> lock(mutex); map.set_value(value, key); }
+};
+
+struct snapshot_map {
+    com::concurrent_vectormap<uint64_t, uint64_t> map;
+
+    uint64_t get_value(uint64_t key) const { return map.get_value(key).at(0); }
+    void set_value(uint64_t value, uint64_t key) { map.set_value(value, key); }
+};
+
+template<class map_>
+static void BM_ConcurrentGet(benchmark::State& state) {
+    static map_ m;
+    if (state.thread_index() == 0) {
+        m.map.clear();
+        for (uint64_t i = 0; i < size; ++i) {
+            m.map.push_back(i, i);
+        }
+    }
+
+    uint64_t key = static_cast<uint64_t>(state.thread_index());
+    uint64_t done = 0;
+    for (auto _ : state) {
+        key = (key * 7 + 3) % size;
+        benchmark::DoNotOptimize(m.get_value(key));
+        if ((state.thread_index() == 0) && (++done % write_every == 0)) {
+            m.set_value(done, key);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ConcurrentGet<mutex_map>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ConcurrentGet<shared_mutex_map>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ConcurrentGet<snapshot_map>)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,36 @@
+#include "vectormap.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+
+template<class map_>
+static void BM_PushBack(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        map_ m;
+        for (size_t i = 0; i < n; ++i) {
+            m.push_back(i, i);
+        }
+        benchmark::DoNotOptimize(m.data());
+    }
+
+    state.SetComplexityN(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+struct bench_key {
+    uint64_t id;
+    bench_key(uint64_t i = 0) : id(i) {}
+    bool operator==(const bench_key&) const = default;
+};
+
+using delta_map = com::vectormap<bench_key, uint64_t, 100>;
+using geometric_map = com::vectormap<bench_key, uint64_t, 100, com::no_index, com::geometric_growth<2>>;
+using geometric_15_map = com::vectormap<bench_key, uint64_t, 100, com::no_index, com::geometric_growth<3, 2>>;
+using hybrid_map = com::vectormap<bench_key, uint64_t, 100, com::no_index, com::hybrid_growth<4096>>;
+
+BENCHMARK(BM_PushBack<delta_map>)->RangeMultiplier(4)->Range(1 << 10, 1 << 17)->Complexity(benchmark::oN);
+BENCHMARK(BM_PushBack<geometric_map>)->RangeMultiplier(4)->Range(1 << 10, 1 << 22)->Complexity(benchmark::oN);
+BENCHMARK(BM_PushBack<geometric_15_map>)->RangeMultiplier(4)->Range(1 << 10, 1 << 22)->Complexity(benchmark::oN);
+BENCHMARK(BM_PushBack<hybrid_map>)->RangeMultiplier(4)->Range(1 << 10, 1 << 22)->Complexity(benchmark::oN);
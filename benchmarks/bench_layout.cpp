@@ -0,0 +1,31 @@
+#include "vectormap.hpp"
+#include "soa_vectormap.hpp"
+#include "benchmark/benchmark.h"
+
+#include <array>
+#include <cstdint>
+
+// 8 byte keys with 200 byte values: the pair layout reads 26 times more memory per key than the key array.
+using payload = std::array<uint64_t, 25>;
+
+template<class map_>
+static void BM_FindMissing(benchmark::State& state) {
+    const auto n = static_cast<uint64_t>(state.range(0));
+    map_ m;
+    for (uint64_t i = 0; i < n; ++i) {
+        m.push_back(i, payload{i});
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.contains(n));
+    }
+
+    state.SetComplexityN(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using aos_map = com::vectormap<uint64_t, payload, 100, com::no_index, com::geometric_growth<2>>;
+using soa_map = com::soa_vectormap<uint64_t, payload, 100, com::geometric_growth<2>>;
+
+BENCHMARK(BM_FindMissing<aos_map>)->RangeMultiplier(8)->Range(1 << 6, 1 << 18)->Complexity(benchmark::oN);
+BENCHMARK(BM_FindMissing<soa_map>)->RangeMultiplier(8)->Range(1 << 6, 1 << 18)->Complexity(benchmark::oN);
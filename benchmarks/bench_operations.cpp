@@ -0,0 +1,541 @@
+#include "vectormap.hpp"
+#include "indexed_vectormap.hpp"
+#include "soa_vectormap.hpp"
+#include "tombstone_vectormap.hpp"
+#include "chunked_vectormap.hpp"
+#include "static_vectormap.hpp"
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+    using key_type = uint64_t;
+    using mapped_type = uint64_t;
+    using pair_type = std::pair<key_type, mapped_type>;
+
+    template<size_t delta_>
+    using delta_map = com::vectormap<key_type, mapped_type, delta_>;
+    using geometric_map = com::vectormap<key_type, mapped_type, 100, com::no_index, com::geometric_growth<2>>;
+    using indexed_map = com::indexed_vectormap<key_type, mapped_type, 100>;
+    using soa_map = com::soa_vectormap<key_type, mapped_type, 100, com::geometric_growth<2>>;
+    using deque_map = com::deque_vectormap<key_type, mapped_type, 100>;
+    using tombstone_map = com::tombstone_vectormap<key_type, mapped_type, 100, com::geometric_growth<2>>;
+    using chunked_map = com::chunked_vectormap<key_type, mapped_type, 512>;
+    using sorted_map = com::sorted_vectormap<key_type, mapped_type, 100>;
+    using stable_map = com::stable_vectormap<key_type, mapped_type, 100>;
+    using vector_map = std::vector<pair_type>;
+    using hash_map = std::unordered_multimap<key_type, mapped_type>;
+
+    // Sorted vector of pairs: the usual flat multimap.
+    struct flat_map {
+        std::vector<pair_type> data;
+
+        static bool less(const pair_type& a, const pair_type& b) { return a.first < b.first; }
+        auto equal_range(key_type key) { return std::equal_range(data.begin(), data.end(), pair_type(key, 0), less); }
+        void insert(key_type key, mapped_type value) {
+            data.insert(std::upper_bound(data.begin(), data.end(), pair_type(key, 0), less), pair_type(key, value));
+        }
+    };
+
+    template<class map_>
+    concept Vectormap = requires { typename map_::iterator_pos; };
+
+    template<class map_>
+    concept Sequence = Vectormap<map_> || std::is_same_v<map_, vector_map>;
+
+    // Operations of the vectormap, written for every container of the comparison.
+    namespace ops {
+        template<class map_>
+        void push_back(map_& m, key_type key, mapped_type value) {
+            if constexpr (Vectormap<map_>) m.push_back(key, value);
+            else if constexpr (std::is_same_v<map_, vector_map>) m.emplace_back(key, value);
+            else if constexpr (std::is_same_v<map_, hash_map>) m.emplace(key, value);
+            else m.insert(key, value);
+        }
+
+        template<class map_>
+        size_t size(const map_& m) {
+            if constexpr (std::is_same_v<map_, flat_map>) return m.data.size();
+            else return m.size();
+        }
+
+        template<class map_>
+        size_t get(map_& m, key_type key) {
+            if constexpr (Vectormap<map_>) return m.get(key).size();
+            else if constexpr (std::is_same_v<map_, vector_map>) return std::find_if(m.begin(), m.end(), [key](const pair_type& e) { return e.first == key; }) != m.end();
+            else if constexpr (std::is_same_v<map_, hash_map>) return m.find(key) != m.end();
+            else { auto range = m.equal_range(key); return range.first != range.second; }
+        }
+
+        template<class map_>
+        size_t get_all(map_& m, key_type key) {
+            if constexpr (Vectormap<map_>) return m.get_all(key).size();
+            else if constexpr (std::is_same_v<map_, vector_map>) return std::count_if(m.begin(), m.end(), [key](const pair_type& e) { return e.first == key; });
+            else if constexpr (std::is_same_v<map_, hash_map>) return m.count(key);
+            else { auto range = m.equal_range(key); return range.second - range.first; }
+        }
+
+        template<class map_>
+        void erase(map_& m, key_type key) {
+            if constexpr (Vectormap<map_>) m.erase(key);
+            else if constexpr (std::is_same_v<map_, vector_map>) {
+                auto it = std::find_if(m.begin(), m.end(), [key](const pair_type& e) { return e.first == key; });
+                if (it != m.end()) m.erase(it);
+            }
+            else if constexpr (std::is_same_v<map_, hash_map>) {
+                auto it = m.find(key);
+                if (it != m.end()) m.erase(it);
+            }
+            else {
+                auto range = m.equal_range(key);
+                if (range.first != range.second) m.data.erase(range.first);
+            }
+        }
+
+        template<class map_>
+        void erase_all(map_& m, key_type key) {
+            if constexpr (Vectormap<map_>) m.erase_all(key);
+            else if constexpr (std::is_same_v<map_, vector_map>) std::erase_if(m, [key](const pair_type& e) { return e.first == key; });
+            else if constexpr (std::is_same_v<map_, hash_map>) m.erase(key);
+            else { auto range = m.equal_range(key); m.data.erase(range.first, range.second); }
+        }
+    }
+
+    // n elements holding n / duplicates distinct keys, spread along the container.
+    template<class map_>
+    map_ make(size_t n, size_t duplicates) {
+        const size_t distinct = std::max<size_t>(1, n / duplicates);
+        map_ m;
+        if constexpr (std::is_same_v<map_, flat_map>) {
+            for (size_t i = 0; i < n; ++i) {
+                m.data.emplace_back(i % distinct, i);
+            }
+            std::stable_sort(m.data.begin(), m.data.end(), flat_map::less);
+        }
+        else {
+            // Reserve so that delta growth does not dominate the setup of the big sizes.
+            if constexpr (Sequence<map_>) m.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                ops::push_back(m, i % distinct, i);
+            }
+        }
+        return m;
+    }
+
+    // Keys to look up: hit_percent % of them are in the container.
+    std::vector<key_type> queries(size_t n, size_t duplicates, size_t hit_percent) {
+        const size_t distinct = std::max<size_t>(1, n / duplicates);
+        std::mt19937_64 gen(42);
+        std::vector<key_type> out(1024);
+        for (key_type& key : out) {
+            key = (gen() % 100 < hit_percent) ? gen() % distinct : distinct + gen() % distinct;
+        }
+        return out;
+    }
+
+    const std::vector<int64_t> sizes = benchmark::CreateRange(8, 10'000'000, 8);
+}
+
+template<class map_>
+static void BM_Append(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        map_ m;
+        for (size_t i = 0; i < n; ++i) {
+            ops::push_back(m, i, i);
+        }
+        benchmark::DoNotOptimize(ops::size(m));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Appends n elements at a time, with one call or one call per element.
+template<class map_, bool batched_>
+static void BM_AppendChunk(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    std::vector<pair_type> chunk;
+    for (size_t i = 0; i < n; ++i) {
+        chunk.emplace_back(i, i);
+    }
+    for (auto _ : state) {
+        map_ m;
+        for (size_t round = 0; round < 8; ++round) {
+            if constexpr (batched_) m.append_range(chunk);
+            else for (const pair_type& elem : chunk) m.push_back(elem.first, elem.second);
+        }
+        benchmark::DoNotOptimize(m.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+}
+
+// One insertion and the erasure that undoes it, so that the size stays n.
+template<class map_>
+static void BM_PushFront(benchmark::State& state) {
+    map_ m = make<map_>(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        if constexpr (Vectormap<map_>) { m.push_front(0, 0); m.erase_at(0); }
+        else { m.insert(m.begin(), pair_type(0, 0)); m.erase(m.begin()); }
+    }
+}
+
+template<class map_>
+static void BM_InsertMiddle(benchmark::State& state) {
+    map_ m = make<map_>(static_cast<size_t>(state.range(0)), 1);
+    const size_t middle = ops::size(m) / 2;
+    for (auto _ : state) {
+        if constexpr (Vectormap<map_>) { m.insert(0, 0, middle); m.erase_at(middle); }
+        else { m.insert(m.begin() + middle, pair_type(0, 0)); m.erase(m.begin() + middle); }
+    }
+}
+
+// Arguments: size, copies of every key, percentage of lookups that hit.
+template<class map_>
+static void BM_Get(benchmark::State& state) {
+    map_ m = make<map_>(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+    const std::vector<key_type> keys = queries(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)), static_cast<size_t>(state.range(2)));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ops::get(m, keys[i++ % keys.size()]));
+    }
+}
+
+template<class map_>
+static void BM_GetAll(benchmark::State& state) {
+    map_ m = make<map_>(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+    const std::vector<key_type> keys = queries(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)), static_cast<size_t>(state.range(2)));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ops::get_all(m, keys[i++ % keys.size()]));
+    }
+}
+
+// Looks up long string keys from std::string_view, building a std::string or not.
+template<class map_, bool transparent_>
+static void BM_GetStringView(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    map_ m;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back("a key long enough to be allocated on the heap #" + std::to_string(i));
+        m.push_back(keys.back(), i);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string_view key = keys[(i++ * 7919) % n];
+        if constexpr (transparent_) benchmark::DoNotOptimize(m.count(key));
+        else benchmark::DoNotOptimize(m.count(std::string(key)));
+    }
+}
+
+// Looks up URLs that share a long prefix, so that every key comparison reads it.
+template<class map_>
+static void BM_GetUrl(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    map_ m;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back("https://example.com/catalog/products/category/item?id=" + std::to_string(i));
+        m.push_back(keys.back(), i);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.get_all(keys[(i++ * 7919) % n]).size());
+    }
+}
+
+// Walks the pages of 16 matches of a key held by a quarter of the elements, by ordinal or resuming from the last match.
+template<class map_, bool cursor_>
+static void BM_GetPage(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    map_ m;
+    for (size_t i = 0; i < n; ++i) {
+        m.push_back(i % 4, i);
+    }
+    size_t ordinal = 1;
+    size_t pos = 0;
+    for (auto _ : state) {
+        if constexpr (cursor_) {
+            for (size_t j = 0; j < 16; ++j) {
+                pos = m.find_next_pos(0, pos);
+                pos = pos != map_::npos ? pos + 1 : 0;
+            }
+            benchmark::DoNotOptimize(pos);
+        }
+        else {
+            const auto page = m.get_pos(0, ordinal, 16);
+            ordinal = page.size() == 16 ? ordinal + 16 : 1;
+            benchmark::DoNotOptimize(page.data());
+        }
+    }
+}
+
+// Counts the elements whose key is in a range of 16 keys, with a sorted index or by copying the elements into a std::multimap.
+template<bool sorted_>
+static void BM_KeyRange(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    sorted_map m;
+    std::mt19937_64 gen(7);
+    for (size_t i = 0; i < n; ++i) {
+        m.push_back(gen() % n, i);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        const key_type first = (i++ * 7919) % n;
+        if constexpr (sorted_) {
+            benchmark::DoNotOptimize(std::ranges::distance(m.range_view(first, first + 16)));
+        }
+        else {
+            const std::multimap<key_type, mapped_type> copy(m.begin(), m.end());
+            benchmark::DoNotOptimize(std::distance(copy.lower_bound(first), copy.lower_bound(first + 16)));
+        }
+    }
+}
+
+// A producer appends batches of 16 elements while a reader keeps using 16 elements found before:
+// the reader looks them up again after every batch, or resolves the handles it took once.
+template<bool handles_>
+static void BM_CachedLookup(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    stable_map m;
+    for (size_t i = 0; i < n; ++i) {
+        m.push_back(i, i);
+    }
+    std::vector<com::stable_handle> cached;
+    for (key_type key = 0; key < 16; ++key) {
+        cached.push_back(m.handle_at(m.find(n - 1 - key * 7) - m.begin()));
+    }
+    std::vector<pair_type> batch(16, pair_type(n, 0));
+    std::vector<com::stable_handle> appended;
+    for (auto _ : state) {
+        appended.clear();
+        m.append_batch(batch, std::back_inserter(appended));
+        for (key_type key = 0; key < 16; ++key) {
+            if constexpr (handles_) {
+                benchmark::DoNotOptimize(m.resolve(cached[key]));
+            }
+            else {
+                benchmark::DoNotOptimize(m.find(n - 1 - key * 7));
+            }
+        }
+        while (m.size() > n) {
+            m.erase_at(m.size() - 1);
+        }
+    }
+}
+
+// Keyword table of the C++ language, the kind of lookup table that is usually a static vectormap.
+constexpr std::pair<std::string_view, uint64_t> keywords[] = {
+    {"alignas", 0}, {"auto", 1}, {"bool", 2}, {"break", 3}, {"case", 4}, {"catch", 5}, {"char", 6}, {"class", 7},
+    {"const", 8}, {"constexpr", 9}, {"continue", 10}, {"default", 11}, {"delete", 12}, {"do", 13}, {"double", 14}, {"else", 15},
+    {"enum", 16}, {"explicit", 17}, {"extern", 18}, {"false", 19}, {"float", 20}, {"for", 21}, {"friend", 22}, {"goto", 23},
+    {"if", 24}, {"inline", 25}, {"int", 26}, {"long", 27}, {"namespace", 28}, {"new", 29}, {"operator", 30}, {"private", 31},
+    {"protected", 32}, {"public", 33}, {"return", 34}, {"short", 35}, {"signed", 36}, {"sizeof", 37}, {"static", 38}, {"struct", 39},
+    {"switch", 40}, {"template", 41}, {"this", 42}, {"throw", 43}, {"true", 44}, {"try", 45}, {"typedef", 46}, {"typename", 47},
+    {"union", 48}, {"unsigned", 49}, {"using", 50}, {"virtual", 51}, {"void", 52}, {"volatile", 53}, {"while", 54}, {"yield", 55}};
+
+// Looks up the keywords in a constexpr static_vectormap or in a vectormap built at startup.
+template<bool static_>
+static void BM_Keyword(benchmark::State& state) {
+    static constexpr com::static_vectormap<std::string_view, uint64_t, std::size(keywords)> table(keywords);
+    const com::vectormap<std::string_view, uint64_t> m(std::begin(keywords), std::end(keywords));
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string_view key = keywords[(i++ * 7) % std::size(keywords)].first;
+        if constexpr (static_) {
+            benchmark::DoNotOptimize(table.find(key));
+        }
+        else {
+            benchmark::DoNotOptimize(m.find(key));
+        }
+    }
+}
+
+// Erases one element and puts it back at the end.
+template<class map_>
+static void BM_Erase(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    map_ m = make<map_>(n, 1);
+    key_type key = 0;
+    for (auto _ : state) {
+        ops::erase(m, key);
+        ops::push_back(m, key, key);
+        key = (key + 1) % n;
+    }
+}
+
+// Arguments: size, copies of every key.
+template<class map_>
+static void BM_EraseAll(benchmark::State& state) {
+    const map_ original = make<map_>(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        map_ m = original;
+        state.ResumeTiming();
+        ops::erase_all(m, 0);
+        benchmark::DoNotOptimize(ops::size(m));
+    }
+}
+
+// FIFO use: pushes at the back and erases from the front, keeping the size constant.
+template<class map_>
+static void BM_Fifo(benchmark::State& state) {
+    const auto n = static_cast<key_type>(state.range(0));
+    map_ m;
+    for (key_type i = 0; i < n; ++i) {
+        m.push_back(i, i);
+    }
+
+    key_type key = n;
+    for (auto _ : state) {
+        m.erase_at(0);
+        m.push_back(key, key);
+        ++key;
+    }
+}
+
+template<class map_>
+static void BM_Move(benchmark::State& state) {
+    map_ m = make<map_>(static_cast<size_t>(state.range(0)), 1);
+    const size_t last = ops::size(m) - 1;
+    for (auto _ : state) {
+        if constexpr (Vectormap<map_>) m.move(0, last);
+        else std::rotate(m.begin(), m.begin() + 1, m.end());
+    }
+}
+
+template<class map_>
+static void BM_Swap(benchmark::State& state) {
+    map_ m = make<map_>(static_cast<size_t>(state.range(0)), 1);
+    const size_t last = ops::size(m) - 1;
+    for (auto _ : state) {
+        if constexpr (Vectormap<map_>) m.swap(0, last);
+        else std::swap(m[0], m[last]);
+        benchmark::ClobberMemory();
+    }
+}
+
+template<class map_>
+static void BM_Resize(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    map_ m = make<map_>(n, 1);
+    for (auto _ : state) {
+        m.resize(2 * n);
+        m.resize(n);
+    }
+}
+
+template<class map_>
+static void BM_Copy(benchmark::State& state) {
+    const map_ original = make<map_>(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        map_ m = original;
+        benchmark::DoNotOptimize(ops::size(m));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Changes one value and publishes a copy, while the previous copy is still in use.
+template<class map_>
+static void BM_CopyAndSet(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    map_ m = make<map_>(n, 1);
+    map_ published = m;
+    size_t i = 0;
+    for (auto _ : state) {
+        m.set_value_at(i, (i * 7919) % n);
+        ++i;
+        published = m;
+        benchmark::DoNotOptimize(ops::size(published));
+    }
+}
+
+template<class map_>
+static void BM_MoveConstruct(benchmark::State& state) {
+    map_ m = make<map_>(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        map_ other(std::move(m));
+        m = std::move(other);
+        benchmark::DoNotOptimize(ops::size(m));
+    }
+}
+
+static void lookup_args(benchmark::internal::Benchmark* b) {
+    b->ArgsProduct({sizes, {1, 16}, {0, 50, 100}});
+}
+
+static void erase_all_args(benchmark::internal::Benchmark* b) {
+    b->ArgsProduct({sizes, {1, 16, 1024}});
+}
+
+#define VECTORMAP_BENCH_ALL(bench, ...) \
+    BENCHMARK(bench<delta_map<100>>)->__VA_ARGS__; \
+    BENCHMARK(bench<geometric_map>)->__VA_ARGS__; \
+    BENCHMARK(bench<indexed_map>)->__VA_ARGS__; \
+    BENCHMARK(bench<soa_map>)->__VA_ARGS__; \
+    BENCHMARK(bench<vector_map>)->__VA_ARGS__; \
+    BENCHMARK(bench<hash_map>)->__VA_ARGS__; \
+    BENCHMARK(bench<flat_map>)->__VA_ARGS__
+
+#define VECTORMAP_BENCH_SEQUENCES(bench, ...) \
+    BENCHMARK(bench<delta_map<100>>)->__VA_ARGS__; \
+    BENCHMARK(bench<geometric_map>)->__VA_ARGS__; \
+    BENCHMARK(bench<soa_map>)->__VA_ARGS__; \
+    BENCHMARK(bench<vector_map>)->__VA_ARGS__
+
+// Delta growth is quadratic: its sizes are capped so that the suite finishes.
+BENCHMARK(BM_Append<delta_map<16>>)->Range(8, 1 << 15);
+BENCHMARK(BM_Append<delta_map<100>>)->Range(8, 1 << 17);
+BENCHMARK(BM_Append<delta_map<1024>>)->Range(8, 1 << 20);
+BENCHMARK(BM_Append<geometric_map>)->Range(8, 10'000'000);
+BENCHMARK(BM_Append<indexed_map>)->Range(8, 10'000'000);
+BENCHMARK(BM_Append<soa_map>)->Range(8, 10'000'000);
+BENCHMARK(BM_Append<vector_map>)->Range(8, 10'000'000);
+BENCHMARK(BM_Append<hash_map>)->Range(8, 10'000'000);
+BENCHMARK(BM_AppendChunk<geometric_map, false>)->Range(8, 100'000);
+BENCHMARK(BM_AppendChunk<geometric_map, true>)->Range(8, 100'000);
+VECTORMAP_BENCH_SEQUENCES(BM_PushFront, Range(8, 10'000'000));
+BENCHMARK(BM_PushFront<deque_map>)->Range(8, 10'000'000);
+VECTORMAP_BENCH_SEQUENCES(BM_InsertMiddle, Range(8, 10'000'000));
+BENCHMARK(BM_InsertMiddle<chunked_map>)->Range(8, 10'000'000);
+VECTORMAP_BENCH_ALL(BM_Get, Apply(lookup_args));
+VECTORMAP_BENCH_ALL(BM_GetAll, Apply(lookup_args));
+BENCHMARK(BM_GetPage<geometric_map, false>)->Range(64, 1 << 16);
+BENCHMARK(BM_GetPage<geometric_map, true>)->Range(64, 1 << 16);
+BENCHMARK(BM_GetPage<indexed_map, false>)->Range(64, 1 << 16);
+BENCHMARK(BM_GetPage<indexed_map, true>)->Range(64, 1 << 16);
+BENCHMARK(BM_KeyRange<false>)->Range(64, 1 << 16);
+BENCHMARK(BM_KeyRange<true>)->Range(64, 1 << 16);
+BENCHMARK(BM_CachedLookup<false>)->Range(64, 1 << 16);
+BENCHMARK(BM_CachedLookup<true>)->Range(64, 1 << 16);
+BENCHMARK(BM_Keyword<false>);
+BENCHMARK(BM_Keyword<true>);
+BENCHMARK(BM_GetUrl<com::vectormap<std::string, uint64_t>>)->Range(8, 1 << 16);
+BENCHMARK(BM_GetUrl<com::fingerprint_vectormap<std::string, uint64_t>>)->Range(8, 1 << 16);
+BENCHMARK(BM_GetStringView<com::vectormap<std::string, uint64_t>, false>)->Range(8, 1 << 12);
+BENCHMARK(BM_GetStringView<com::vectormap<std::string, uint64_t>, true>)->Range(8, 1 << 12);
+BENCHMARK(BM_GetStringView<com::indexed_vectormap<std::string, uint64_t, 100, com::string_hash, std::equal_to<>>, false>)->Range(8, 1 << 12);
+BENCHMARK(BM_GetStringView<com::indexed_vectormap<std::string, uint64_t, 100, com::string_hash, std::equal_to<>>, true>)->Range(8, 1 << 12);
+VECTORMAP_BENCH_ALL(BM_Erase, Range(8, 1 << 20));
+VECTORMAP_BENCH_ALL(BM_EraseAll, Apply(erase_all_args));
+BENCHMARK(BM_Fifo<geometric_map>)->Range(8, 1 << 20);
+BENCHMARK(BM_Fifo<tombstone_map>)->Range(8, 1 << 20);
+BENCHMARK(BM_Fifo<deque_map>)->Range(8, 1 << 20);
+VECTORMAP_BENCH_SEQUENCES(BM_Move, Range(8, 10'000'000));
+BENCHMARK(BM_Move<chunked_map>)->Range(8, 10'000'000);
+VECTORMAP_BENCH_SEQUENCES(BM_Swap, Range(8, 10'000'000));
+BENCHMARK(BM_Resize<delta_map<100>>)->Range(8, 10'000'000);
+BENCHMARK(BM_Resize<geometric_map>)->Range(8, 10'000'000);
+BENCHMARK(BM_Resize<soa_map>)->Range(8, 10'000'000);
+VECTORMAP_BENCH_ALL(BM_Copy, Range(8, 10'000'000));
+BENCHMARK(BM_Copy<chunked_map>)->Range(8, 10'000'000);
+BENCHMARK(BM_CopyAndSet<geometric_map>)->Range(8, 10'000'000);
+BENCHMARK(BM_CopyAndSet<chunked_map>)->Range(8, 10'000'000);
+VECTORMAP_BENCH_ALL(BM_MoveConstruct, Range(8, 10'000'000));
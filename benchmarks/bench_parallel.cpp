@@ -0,0 +1,46 @@
+#include "vectormap.hpp"
+#include "vectormap_parallel.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <execution>
+
+// Key lookups over vectormaps too large for the cache, one match every 1024 elements.
+using map_type = com::vectormap<uint64_t, uint64_t, 100, com::no_index, com::geometric_growth<2>>;
+
+static map_type make(uint64_t n) {
+    map_type m;
+    m.reserve(n);
+    for (uint64_t i = 0; i < n; ++i) {
+        m.push_back(i % 1024, i);
+    }
+    return m;
+}
+
+static void BM_GetAllSequential(benchmark::State& state) {
+    map_type m = make(static_cast<uint64_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.get_all_values(7));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_GetAllParallel(benchmark::State& state) {
+    map_type m = make(static_cast<uint64_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(com::get_all_values(std::execution::par, m, 7));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ForEachValueParallel(benchmark::State& state) {
+    map_type m = make(static_cast<uint64_t>(state.range(0)));
+    for (auto _ : state) {
+        com::for_each_value(std::execution::par_unseq, m, [](uint64_t& value) { value = value * 3 + 1; });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_GetAllSequential)->RangeMultiplier(8)->Range(1 << 15, 1 << 24)->UseRealTime();
+BENCHMARK(BM_GetAllParallel)->RangeMultiplier(8)->Range(1 << 15, 1 << 24)->UseRealTime();
+BENCHMARK(BM_ForEachValueParallel)->RangeMultiplier(8)->Range(1 << 15, 1 << 24)->UseRealTime();
@@ -0,0 +1,576 @@
+#ifndef __CHUNKEDVECTORMAP_H__
+#define __CHUNKEDVECTORMAP_H__
+
+#include "vectormap.hpp"
+
+#include <bit>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace com {
+    /**
+     * @brief vectormap split in a sequence of small vectormaps (chunks) of up to 2 * chunk_ elements.\n
+     *        Inserting, erasing or moving an element only shifts the elements of the chunks involved,
+     *        so editing the middle of a big map costs O(chunk_) instead of O(n).
+     *        A full chunk is split in two halves and a chunk that gets below chunk_ / 2 elements is merged
+     *        with a neighbour when both fit in chunk_ elements.
+     *
+     *        Positions are global: get_at(pos) is mapped to its chunk with a Fenwick tree of the chunk sizes, in O(log n).
+     *        Key lookups scan the chunks in order with the vectormap key scan, including its SIMD path.
+     *
+     *        Copies share the chunks (copy on write): copying costs one pointer per chunk, and modifying
+     *        a copy clones only the chunks it touches. Use a const reference to read a copy, since
+     *        the non const iterators and operator[] clone the chunk of the element they give access to.
+     *
+     * @tparam key_   Type of the key.
+     * @tparam value_ Type of the value.
+     * @tparam chunk_ Number of elements of a chunk after a split, and growth step of the chunks.
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_ = 512>
+    class chunked_vectormap
+    {
+        static_assert(chunk_ >= 2, "chunked_vectormap needs chunks of at least 2 elements");
+
+        public:
+            template<bool const_> class Iterator;
+
+            /** @cond */
+            using chunk_type = vectormap<key_, value_, chunk_>;
+            using key_type = key_;
+            using mapped_type = value_;
+            using value_type = typename chunk_type::value_type;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+            using size_type = size_t;
+            using iterator_pos = std::pair<iterator, size_type>;
+            using snapshot_type = std::shared_ptr<const chunked_vectormap>;
+
+            static constexpr size_type npos = std::numeric_limits<size_type>::max();
+            static constexpr bool positional_overloads = chunk_type::positional_overloads;
+            /** @endcond */
+
+            /**
+             * @brief Bidirectional iterator over the elements, chunk after chunk.
+             */
+            template<bool const_>
+            class Iterator {
+                public:
+                    using owner_pointer = std::conditional_t<const_, const chunked_vectormap*, chunked_vectormap*>;
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = typename chunked_vectormap::value_type;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<const_, const value_type*, value_type*>;
+                    using reference = std::conditional_t<const_, const value_type&, value_type&>;
+
+                    Iterator(owner_pointer owner = nullptr, size_type chunk = 0, size_type offset = 0) : owner_(owner), index_(chunk), offset_(offset) {}
+                    operator Iterator<true>() const requires (!const_) { return Iterator<true>(owner_, index_, offset_); }
+
+                    reference operator*() const {
+                        if constexpr (const_) return (*owner_->chunks_[index_])[offset_];
+                        else return owner_->edit_(index_)[offset_];
+                    }
+                    pointer operator->() const { return &**this; }
+                    Iterator& operator++() {
+                        if (++offset_ == owner_->chunks_[index_]->size()) {
+                            ++index_;
+                            offset_ = 0;
+                        }
+                        return *this;
+                    }
+                    Iterator operator++(int) { Iterator tmp = *this; ++*this; return tmp; }
+                    Iterator& operator--() {
+                        if (offset_ == 0) {
+                            offset_ = owner_->chunks_[--index_]->size();
+                        }
+                        --offset_;
+                        return *this;
+                    }
+                    Iterator operator--(int) { Iterator tmp = *this; --*this; return tmp; }
+                    bool operator==(const Iterator& other) const { return (index_ == other.index_) && (offset_ == other.offset_); }
+
+                    /**
+                     * @brief Index of the chunk holding the element.
+                     */
+                    size_type chunk() const { return index_; }
+                    /**
+                     * @brief Position of the element in its chunk.
+                     */
+                    size_type offset() const { return offset_; }
+
+                private:
+                    owner_pointer owner_;
+                    size_type index_;
+                    size_type offset_;
+            };
+
+            /** @name Constructors */
+            /** @{ */
+            chunked_vectormap() = default;
+            chunked_vectormap(const std::initializer_list<value_type>& il);
+            /** @} */
+
+            /** @name Element insertion */
+            /** @{ */
+            /**
+             * @brief Constructs an element in place at a given position.\n
+             *        Only the elements of its chunk behind it are shifted.
+             *
+             * @param pos        Position of the new element.
+             * @param args       Arguments forwarded to the constructor of the element.
+             * @return iterator  Iterator pointing to the added element, end() if pos is out of range.
+             */
+            template<class... Args>
+            iterator emplace(const size_type pos, Args&&... args);
+            template<class... Args>
+            iterator emplace_back(Args&&... args) { return emplace(size_, std::forward<Args>(args)...); }
+            iterator insert(const value_type& val, const size_type pos) { return emplace(pos, val); }
+            iterator insert(const key_type& key, const mapped_type& val, const size_type pos) { return emplace(pos, key, val); }
+            iterator push_back(const value_type& val) { return emplace(size_, val); }
+            iterator push_back(const key_type& key, const mapped_type& val) { return emplace(size_, key, val); }
+            iterator push_front(const value_type& val) { return emplace(0, val); }
+            iterator push_front(const key_type& key, const mapped_type& val) { return emplace(0, key, val); }
+            /** @} */
+
+            /** @name Element access */
+            /** @{ */
+            iterator get(const size_type pos) requires positional_overloads { return get_at(pos); }
+            const key_type& get_key(const size_type pos) const requires positional_overloads { return get_key_at(pos); }
+            mapped_type& get_value(const size_type pos) requires positional_overloads { return get_value_at(pos); }
+            const mapped_type& get_value(const size_type pos) const requires positional_overloads { return get_value_at(pos); }
+            std::vector<mapped_type> get_value(const key_type& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<mapped_type> get_all_values(const key_type& key) const;
+            std::vector<size_type> get_pos(const key_type& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<size_type> get_all_pos(const key_type& key) const;
+            iterator get_at(const size_type pos) { if (pos >= size_) return end(); auto [c, offset] = locate_(pos); return iterator(this, c, offset); }
+            const_iterator get_at(const size_type pos) const { if (pos >= size_) return end(); auto [c, offset] = locate_(pos); return const_iterator(this, c, offset); }
+            const key_type& get_key_at(const size_type pos) const { return pos < size_ ? (*this)[pos].first : void_key_type_; }
+            mapped_type& get_value_at(const size_type pos) { return pos < size_ ? (*this)[pos].second : discarded_value<mapped_type>(); }
+            const mapped_type& get_value_at(const size_type pos) const { return pos < size_ ? (*this)[pos].second : void_mapped_type_; }
+            reference operator[](const size_type pos) { auto [c, offset] = locate_(pos); return edit_(c)[offset]; }
+            const_reference operator[](const size_type pos) const { auto [c, offset] = locate_(pos); return (*chunks_[c])[offset]; }
+            iterator find(const key_type& key) { return find_nth(key, 1); }
+            const_iterator find(const key_type& key) const { return find_nth(key, 1); }
+            iterator find_nth(const key_type& key, size_type ordinal);
+            const_iterator find_nth(const key_type& key, size_type ordinal) const;
+            size_type count(const key_type& key) const;
+            bool contains(const key_type& key) const { return find(key) != end(); }
+            /** @} */
+
+            /** @name  Element modification */
+            /** @{ */
+            void set_value(const mapped_type& new_mapped_value, const key_type& key, size_type ordinal = 1);
+            void set_value_at(const mapped_type& new_mapped_value, const size_type pos) { if (pos < size_) (*this)[pos].second = new_mapped_value; }
+            void set_key_at(const key_type& new_key, const size_type pos) { if (pos < size_) { auto [c, offset] = locate_(pos); edit_(c).set_key_at(new_key, offset); } }
+            /** @} */
+
+            /** @name  Element management */
+            /** @{ */
+            void clear();
+            void erase(const size_type pos) requires positional_overloads { erase_at(pos); }
+            /**
+             * @brief Erases the element at a given position.\n
+             *        Only the elements of its chunk behind it are shifted.
+             *
+             * @param pos  Position of the element.
+             */
+            void erase_at(const size_type pos);
+            void erase(const key_type& key);
+            size_type erase_all(const key_type& key);
+            /**
+             * @brief Moves the element at from to the position to, shifting the elements in between.\n
+             *        It costs O(chunk_): within a chunk it is a vectormap::move, otherwise an erasure and an insertion.
+             *
+             * @param from  Position of the element.
+             * @param to    Position of the element after the move.
+             */
+            void move(const size_type from, const size_type to);
+            void swap(const size_type from, const size_type to);
+            /** @} */
+
+            /** @name  Memory manipulation */
+            /** @{ */
+            size_type size() const { return size_; }
+            bool is_empty() const { return size_ == 0; }
+            /**
+             * @brief Reserves room for the chunks of min_capacity elements; the chunks allocate their own elements.
+             */
+            bool reserve(size_type min_capacity) { chunks_.reserve(min_capacity / chunk_ + 1); return true; }
+            /**
+             * @brief Number of chunks.
+             */
+            size_type chunks() const { return chunks_.size(); }
+            /**
+             * @brief Chunk at a given index.
+             */
+            const chunk_type& chunk(const size_type index) const { return *chunks_[index]; }
+            /**
+             * @brief Immutable copy of the map, that can be handed to other threads.\n
+             *        It shares the chunks with the map: taking it costs one pointer per chunk, and the
+             *        map clones a chunk the first time it modifies it afterwards.
+             *
+             * @return snapshot_type  Shared pointer to the copy.
+             */
+            snapshot_type snapshot() const { return std::make_shared<const chunked_vectormap>(*this); }
+            /** @} */
+
+            /** @name  Iterators */
+            /** @{ */
+            iterator begin() { return iterator(this, 0, 0); }
+            iterator end() { return iterator(this, chunks_.size(), 0); }
+            const_iterator begin() const { return const_iterator(this, 0, 0); }
+            const_iterator end() const { return const_iterator(this, chunks_.size(), 0); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+            /** @} */
+
+        private:
+            std::vector<std::shared_ptr<chunk_type>> chunks_;   // None is empty, shared with the copies until modified.
+            std::vector<size_type> tree_{0};    // Fenwick tree of the chunk sizes, 1-based.
+            size_type size_ = 0;
+            static inline const mapped_type void_mapped_type_{};
+            static inline const key_type void_key_type_{};
+
+            chunk_type& edit_(size_type chunk);
+            static void relocate_(value_type* dst, value_type* src);
+            void add_(size_type chunk, std::ptrdiff_t delta);
+            std::pair<size_type, size_type> locate_(size_type pos) const;
+            void split_(size_type chunk);
+            void merge_(size_type chunk);
+            void rebuild_();
+
+            template<class F>
+            void for_each_pos_(const key_type& key, F&& f) const;
+    };
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    chunked_vectormap<key_, value_, chunk_>::chunked_vectormap(const std::initializer_list<value_type>& il) {
+        for (const value_type& val : il) {
+            push_back(val);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    template<class... Args>
+    typename chunked_vectormap<key_, value_, chunk_>::iterator chunked_vectormap<key_, value_, chunk_>::emplace(const size_type pos, Args&&... args) {
+        if (pos > size_) {
+            return end();
+        }
+
+        if (chunks_.empty()) {
+            chunks_.push_back(std::make_shared<chunk_type>());
+            rebuild_();
+        }
+
+        // Appending goes to the last chunk, not to a new one.
+        size_type c = chunks_.size() - 1;
+        size_type offset = chunks_[c]->size();
+        if (pos < size_) {
+            std::tie(c, offset) = locate_(pos);
+        }
+
+        edit_(c).emplace(offset, std::forward<Args>(args)...);
+        add_(c, 1);
+        ++size_;
+
+        if (chunks_[c]->size() >= 2 * chunk_) {
+            split_(c);
+            if (offset >= chunk_) {
+                ++c;
+                offset -= chunk_;
+            }
+        }
+        return iterator(this, c, offset);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    std::vector<typename chunked_vectormap<key_, value_, chunk_>::mapped_type> chunked_vectormap<key_, value_, chunk_>::get_value(const key_type& key, size_type ordinal, size_type number) const {
+        std::vector<mapped_type> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type c, size_type offset, size_type) {
+            if (order >= ordinal) {
+                out.push_back((*chunks_[c])[offset].second);
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    std::vector<typename chunked_vectormap<key_, value_, chunk_>::mapped_type> chunked_vectormap<key_, value_, chunk_>::get_all_values(const key_type& key) const {
+        std::vector<mapped_type> out;
+        for_each_pos_(key, [&](size_type c, size_type offset, size_type) {
+            out.push_back((*chunks_[c])[offset].second);
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    std::vector<typename chunked_vectormap<key_, value_, chunk_>::size_type> chunked_vectormap<key_, value_, chunk_>::get_pos(const key_type& key, size_type ordinal, size_type number) const {
+        std::vector<size_type> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type, size_type, size_type pos) {
+            if (order >= ordinal) {
+                out.push_back(pos);
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    std::vector<typename chunked_vectormap<key_, value_, chunk_>::size_type> chunked_vectormap<key_, value_, chunk_>::get_all_pos(const key_type& key) const {
+        std::vector<size_type> out;
+        for_each_pos_(key, [&](size_type, size_type, size_type pos) {
+            out.push_back(pos);
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    typename chunked_vectormap<key_, value_, chunk_>::iterator chunked_vectormap<key_, value_, chunk_>::find_nth(const key_type& key, size_type ordinal) {
+        iterator out = end();
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type c, size_type offset, size_type) {
+            if (order++ >= ordinal) {
+                out = iterator(this, c, offset);
+                return false;
+            }
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    typename chunked_vectormap<key_, value_, chunk_>::const_iterator chunked_vectormap<key_, value_, chunk_>::find_nth(const key_type& key, size_type ordinal) const {
+        return const_cast<chunked_vectormap*>(this)->find_nth(key, ordinal);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    typename chunked_vectormap<key_, value_, chunk_>::size_type chunked_vectormap<key_, value_, chunk_>::count(const key_type& key) const {
+        size_type out = 0;
+        for (const auto& c : chunks_) {
+            out += c->count(key);
+        }
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::set_value(const mapped_type& new_mapped_value, const key_type& key, size_type ordinal) {
+        iterator it = find_nth(key, ordinal);
+        if (it != end()) {
+            it->second = new_mapped_value;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::clear() {
+        chunks_.clear();
+        size_ = 0;
+        rebuild_();
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::erase_at(const size_type pos) {
+        if (pos < size_) {
+            auto [c, offset] = locate_(pos);
+            edit_(c).erase_at(offset);
+            add_(c, -1);
+            --size_;
+            merge_(c);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::erase(const key_type& key) {
+        iterator it = find(key);
+        if (it != end()) {
+            edit_(it.chunk()).erase_at(it.offset());
+            add_(it.chunk(), -1);
+            --size_;
+            merge_(it.chunk());
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    typename chunked_vectormap<key_, value_, chunk_>::size_type chunked_vectormap<key_, value_, chunk_>::erase_all(const key_type& key) {
+        size_type out = 0;
+        for (size_type c = 0; c < chunks_.size(); ++c) {
+            // Only the chunks holding key are cloned.
+            if (chunks_[c]->contains(key)) {
+                out += edit_(c).erase_all(key);
+            }
+        }
+        if (out == 0) {
+            return 0;
+        }
+
+        std::erase_if(chunks_, [](const auto& c) { return c->is_empty(); });
+        size_ -= out;
+        rebuild_();
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::move(const size_type from, const size_type to) {
+        if ((from < size_) && (to < size_) && (from != to)) {
+            const auto [c, offset] = locate_(from);
+
+            if ((to >= from - offset) && (to < from - offset + chunks_[c]->size())) {
+                edit_(c).move(offset, to - (from - offset));
+            }
+            else {
+                value_type temp(std::move(edit_(c)[offset]));
+                erase_at(from);
+                emplace(to, std::move(temp));
+            }
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::swap(const size_type from, const size_type to) {
+        if ((from < size_) && (to < size_) && (from != to)) {
+            const auto [c_from, offset_from] = locate_(from);
+            const auto [c_to, offset_to] = locate_(to);
+
+            if (c_from == c_to) {
+                edit_(c_from).swap(offset_from, offset_to);
+            }
+            else {
+                // Relocated through a buffer, as within a chunk: the chunks are not indexed, so no hook is due.
+                value_type* a = edit_(c_from).data() + offset_from;
+                value_type* b = edit_(c_to).data() + offset_to;
+                alignas(value_type) unsigned char buffer[sizeof(value_type)];
+                value_type* temp = reinterpret_cast<value_type*>(buffer);
+
+                relocate_(temp, b);
+                relocate_(b, a);
+                relocate_(a, temp);
+            }
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    typename chunked_vectormap<key_, value_, chunk_>::chunk_type& chunked_vectormap<key_, value_, chunk_>::edit_(size_type chunk) {
+        // A chunk only owned by this map cannot be shared meanwhile: copying it needs this map.
+        if (chunks_[chunk].use_count() > 1) {
+            chunks_[chunk] = std::make_shared<chunk_type>(*chunks_[chunk]);
+        }
+        return *chunks_[chunk];
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::relocate_(value_type* dst, value_type* src) {
+        // The key is const only to the users; the element is destroyed right after being moved from.
+        std::construct_at(dst, std::move_if_noexcept(const_cast<key_type&>(src->first)), std::move_if_noexcept(src->second));
+        std::destroy_at(src);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::add_(size_type chunk, std::ptrdiff_t delta) {
+        for (size_type i = chunk + 1; i < tree_.size(); i += i & (~i + 1)) {
+            tree_[i] += delta;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    std::pair<typename chunked_vectormap<key_, value_, chunk_>::size_type, typename chunked_vectormap<key_, value_, chunk_>::size_type> chunked_vectormap<key_, value_, chunk_>::locate_(size_type pos) const {
+        // Descend the Fenwick tree to the chunk holding pos; the remainder is the offset in that chunk.
+        size_type c = 0;
+        for (size_type step = std::bit_floor(tree_.size() - 1); step > 0; step >>= 1) {
+            if ((c + step < tree_.size()) && (tree_[c + step] <= pos)) {
+                c += step;
+                pos -= tree_[c];
+            }
+        }
+
+        return std::make_pair(c, pos);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::split_(size_type chunk) {
+        chunk_type& lower = edit_(chunk);
+        auto upper = std::make_shared<chunk_type>();
+        upper->reserve(2 * chunk_);
+        for (size_type i = chunk_; i < lower.size(); ++i) {
+            upper->emplace_back(std::move(lower[i]));
+        }
+        lower.erase_if([i = size_type(0)](const value_type&) mutable { return i++ >= chunk_; });
+
+        chunks_.insert(chunks_.begin() + static_cast<std::ptrdiff_t>(chunk + 1), std::move(upper));
+        rebuild_();
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::merge_(size_type chunk) {
+        if (chunks_[chunk]->is_empty()) {
+            chunks_.erase(chunks_.begin() + static_cast<std::ptrdiff_t>(chunk));
+            rebuild_();
+            return;
+        }
+        if (chunks_[chunk]->size() >= chunk_ / 2) {
+            return;
+        }
+
+        // Merge with the smallest neighbour, if both fit in one chunk.
+        size_type left = chunk;
+        if ((chunk > 0) && ((chunk + 1 == chunks_.size()) || (chunks_[chunk - 1]->size() < chunks_[chunk + 1]->size()))) {
+            left = chunk - 1;
+        }
+        if ((left + 1 < chunks_.size()) && (chunks_[left]->size() + chunks_[left + 1]->size() <= chunk_)) {
+            // The right chunk is dropped: its elements are moved from it, unless a copy still uses them.
+            if (chunks_[left + 1].use_count() > 1) {
+                edit_(left).push_back(*chunks_[left + 1]);
+            }
+            else {
+                edit_(left).push_back(std::move(*chunks_[left + 1]));
+            }
+            chunks_.erase(chunks_.begin() + static_cast<std::ptrdiff_t>(left + 1));
+            rebuild_();
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    void chunked_vectormap<key_, value_, chunk_>::rebuild_() {
+        const size_type n = chunks_.size();
+        tree_.assign(n + 1, 0);
+        for (size_type i = 1; i <= n; ++i) {
+            tree_[i] += chunks_[i - 1]->size();
+            const size_type parent = i + (i & (~i + 1));
+            if (parent <= n) {
+                tree_[parent] += tree_[i];
+            }
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t chunk_>
+    template<class F>
+    void chunked_vectormap<key_, value_, chunk_>::for_each_pos_(const key_type& key, F&& f) const {
+        size_type base = 0;
+        for (size_type c = 0; c < chunks_.size(); ++c) {
+            const chunk_type& chunk = *chunks_[c];
+            if (!chunk.for_each_pos(key, 0, chunk.size(), [&](size_type offset) { return f(c, offset, base + offset); })) {
+                return;
+            }
+            base += chunk.size();
+        }
+    }
+}
+#endif
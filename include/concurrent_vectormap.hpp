@@ -0,0 +1,124 @@
+#ifndef __CONCURRENTVECTORMAP_H__
+#define __CONCURRENTVECTORMAP_H__
+
+#include "vectormap.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace com {
+    /**
+     * @brief Vectormap shared by many reader threads and a few writer threads.\n
+     *        Readers work on an immutable snapshot, loaded with a single atomic operation: they never block
+     *        on an update in progress, only on the pointer swap that publishes it. std::atomic<std::shared_ptr>
+     *        is not lock-free in the common standard libraries, so loads and swaps still take a short internal lock.
+     *        Writers are serialized among themselves, apply their changes to a private copy and publish it
+     *        as the new snapshot.
+     *
+     *        Every update copies the whole vectormap, even to change a single element, so writers should
+     *        group their changes in one call to update.
+     *        A snapshot stays valid, and unchanged, for as long as a reader holds it.
+     *
+     * @tparam key_      Type of the key.
+     * @tparam value_    Type of the value.
+     * @tparam delta_    Increment of the container capacity when it is full.
+     * @tparam indexing_ Index policy of the snapshots.
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100, class indexing_ = no_index>
+    class concurrent_vectormap
+    {
+        public:
+            /** @cond */
+            using map_type = vectormap<key_, value_, delta_, indexing_>;
+            using snapshot_type = std::shared_ptr<const map_type>;
+            using key_type = typename map_type::key_type;
+            using mapped_type = typename map_type::mapped_type;
+            using value_type = typename map_type::value_type;
+            using size_type = typename map_type::size_type;
+            /** @endcond */
+
+            /** @name Constructors */
+            /** @{ */
+            concurrent_vectormap() : snapshot_(std::make_shared<const map_type>()) {}
+            concurrent_vectormap(std::initializer_list<value_type> il) : snapshot_(std::make_shared<const map_type>(il)) {}
+            explicit concurrent_vectormap(map_type map) : snapshot_(std::make_shared<const map_type>(std::move(map))) {}
+            concurrent_vectormap(const concurrent_vectormap&) = delete;
+            concurrent_vectormap& operator=(const concurrent_vectormap&) = delete;
+            /** @} */
+
+            /** @name Readers */
+            /** @{ */
+            /**
+             * @brief Current version of the vectormap. Later writes do not change it.
+             */
+            snapshot_type snapshot() const { return snapshot_.load(std::memory_order_acquire); }
+            /**
+             * @brief Calls f with the current version of the vectormap and returns its result.
+             *
+             * @param f  Callable with (const map_type&).
+             */
+            template<class F>
+            decltype(auto) read(F&& f) const { snapshot_type s = snapshot(); return std::forward<F>(f)(*s); }
+            std::vector<mapped_type> get_value(const key_type& key, size_type ordinal = 1, size_type number = 1) const { return snapshot()->get_value(key, ordinal, number); }
+            std::vector<mapped_type> get_all_values(const key_type& key) const { return snapshot()->get_all_values(key); }
+            size_type count(const key_type& key) const { return snapshot()->count(key); }
+            bool contains(const key_type& key) const { return snapshot()->contains(key); }
+            size_type size() const { return snapshot()->size(); }
+            bool is_empty() const { return snapshot()->is_empty(); }
+            /** @} */
+
+            /** @name Writers */
+            /** @{ */
+            /**
+             * @brief Applies f to a copy of the current version and publishes the copy, as a single change for the readers.\n
+             *        The copy is of the whole vectormap, whatever f changes.
+             *
+             * @param f  Callable with (map_type&). Its result is returned by value: a reference would point into the
+             *           new version, which the next writer may replace and free at any time.
+             */
+            template<class F>
+            auto update(F&& f);
+            /**
+             * @brief Publishes map as the new version.
+             */
+            void publish(map_type map);
+            void push_back(const key_type& key, const mapped_type& value) { update([&](map_type& m) { m.push_back(key, value); }); }
+            void set_value(const mapped_type& value, const key_type& key, size_type ordinal = 1) { update([&](map_type& m) { m.set_value(value, key, ordinal); }); }
+            void erase(const key_type& key) { update([&](map_type& m) { m.erase(key); }); }
+            void clear() { publish(map_type()); }
+            /** @} */
+
+        private:
+            std::atomic<snapshot_type> snapshot_;
+            std::mutex writer_;
+    };
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_>
+    template<class F>
+    auto concurrent_vectormap<key_, value_, delta_, indexing_>::update(F&& f) {
+        std::lock_guard<std::mutex> lock(writer_);
+        auto next = std::make_shared<map_type>(*snapshot_.load(std::memory_order_relaxed));
+
+        if constexpr (std::is_void_v<std::invoke_result_t<F, map_type&>>) {
+            std::forward<F>(f)(*next);
+            snapshot_.store(std::move(next), std::memory_order_release);
+        }
+        else {
+            auto out = std::forward<F>(f)(*next);
+            snapshot_.store(std::move(next), std::memory_order_release);
+            return out;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_>
+    void concurrent_vectormap<key_, value_, delta_, indexing_>::publish(map_type map) {
+        auto next = std::make_shared<const map_type>(std::move(map));
+        std::lock_guard<std::mutex> lock(writer_);
+        snapshot_.store(std::move(next), std::memory_order_release);
+    }
+}
+#endif
@@ -0,0 +1,654 @@
+#ifndef __INDEXEDVECTORMAP_H__
+#define __INDEXEDVECTORMAP_H__
+
+#include "vectormap.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace com {
+    /**
+     * @brief Transparent hash of string keys: std::string, std::string_view and const char* with equal characters hash equally.\n
+     *        With std::equal_to<>, it lets a hash_index look up any of them without building a key.
+     */
+    struct string_hash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view key) const { return std::hash<std::string_view>()(key); }
+    };
+
+    /**
+     * @brief Index policy that keeps, for every key, the ascending list of positions holding it.\n
+     *        Key lookups cost a hash table access plus the number of matches, independently of
+     *        the size of the vectormap and of the number of distinct keys.
+     *
+     *        Appending elements at the end costs O(1). Inserting, erasing or moving in the middle
+     *        updates the positions behind the modified one, which the vectormap has to shift anyway.
+     *
+     *        Other key types are looked up without conversion when hash_ and equal_ are transparent
+     *        (e.g. string_hash and std::equal_to<>); otherwise they are converted to key_ first.
+     *
+     * @tparam key_   Type of the key.
+     * @tparam hash_  Hash function of the key.
+     * @tparam equal_ Equality comparison of the key.
+     */
+    template<class key_, class hash_ = std::hash<key_>, class equal_ = std::equal_to<key_>>
+    class hash_index {
+        public:
+            /** @cond */
+            using key_type = key_;
+            using size_type = size_t;
+            using positions_type = std::vector<size_type>;
+            /** @endcond */
+
+            static constexpr bool enabled = true;
+            static constexpr bool transparent = requires { typename hash_::is_transparent; typename equal_::is_transparent; };
+
+            template<class map_>
+            void inserted(const map_& map, size_type pos, size_type count) {
+                if (pos + count < map.size()) {
+                    shift_(pos, map.size(), count, true);
+                }
+                for (size_type i = pos; i < pos + count; ++i) {
+                    add_(map.data()[i].first, i);
+                }
+            }
+
+            template<class map_>
+            void erasing(const map_& map, size_type pos, size_type count) {
+                for (size_type i = pos; i < pos + count; ++i) {
+                    remove_(map.data()[i].first, i);
+                }
+                if (pos + count < map.size()) {
+                    shift_(pos + count, map.size(), count, false);
+                }
+            }
+
+            template<class map_>
+            void moved(const map_& map, size_type from, size_type to) {
+                const key_type& key = map.data()[to].first;
+                remove_(key, from);
+                if (from < to) {
+                    shift_(from + 1, to + 1, 1, false);
+                }
+                else {
+                    shift_(to, from, 1, true);
+                }
+                add_(key, to);
+            }
+
+            template<class map_>
+            void swapped(const map_& map, size_type a, size_type b) {
+                const key_type& key_a = map.data()[a].first;
+                const key_type& key_b = map.data()[b].first;
+                if (!equal_()(key_a, key_b)) {
+                    remove_(key_a, b);
+                    add_(key_a, a);
+                    remove_(key_b, a);
+                    add_(key_b, b);
+                }
+            }
+
+            template<class map_>
+            void key_changing(const map_& map, size_type pos, const key_type& new_key) {
+                const key_type& old_key = map.data()[pos].first;
+                if (!equal_()(old_key, new_key)) {
+                    remove_(old_key, pos);
+                    add_(new_key, pos);
+                }
+            }
+
+            void cleared() { positions_.clear(); }
+
+            /**
+             * @brief Positions holding a key.
+             *
+             * @param key                     Key to look for.
+             * @return const positions_type*  Ascending list of positions holding key, nullptr if there is none.
+             */
+            template<class K>
+            requires std::same_as<K, key_type> || transparent || std::constructible_from<key_type, const K&>
+            const positions_type* positions(const K& key) const {
+                if constexpr (std::same_as<K, key_type> || transparent) {
+                    auto it = positions_.find(key);
+                    return it != positions_.end() ? &it->second : nullptr;
+                }
+                else {
+                    return positions(key_type(key));
+                }
+            }
+
+            /**
+             * @brief Number of distinct keys in the index.
+             */
+            size_type keys() const { return positions_.size(); }
+
+        private:
+            std::unordered_map<key_type, positions_type, hash_, equal_> positions_;
+
+            void add_(const key_type& key, size_type pos) {
+                positions_type& list = positions_[key];
+                list.insert(std::upper_bound(list.begin(), list.end(), pos), pos);
+            }
+
+            void remove_(const key_type& key, size_type pos) {
+                auto it = positions_.find(key);
+                if (it != positions_.end()) {
+                    positions_type& list = it->second;
+                    auto elem = std::lower_bound(list.begin(), list.end(), pos);
+                    if ((elem != list.end()) && (*elem == pos)) {
+                        list.erase(elem);
+                    }
+                    if (list.empty()) {
+                        positions_.erase(it);
+                    }
+                }
+            }
+
+            // Adds (up == true) or subtracts delta to every position in [from, to).
+            void shift_(size_type from, size_type to, size_type delta, bool up) {
+                for (auto& elem : positions_) {
+                    positions_type& list = elem.second;
+                    auto first = std::lower_bound(list.begin(), list.end(), from);
+                    for (auto it = first; (it != list.end()) && (*it < to); ++it) {
+                        *it = up ? *it + delta : *it - delta;
+                    }
+                }
+            }
+    };
+
+    /**
+     * @brief Index policy that keeps a one byte fingerprint of the hash of every key, in an array parallel to the elements.\n
+     *        The key scans compare the fingerprints first, many per instruction with SIMD, and only compare the
+     *        keys whose fingerprint matches, which filters out all but about 1 in 256 of the other keys.
+     *        It pays off when comparing two keys is expensive, e.g. long strings sharing a prefix.
+     *        Integral and enumeration keys are already scanned with SIMD and do not use it.
+     *
+     *        Unlike hash_index, the lookups stay linear: the index costs one byte per element and one hash
+     *        per inserted element or changed key, and inserting in the middle shifts one byte per element behind.
+     *        The erasures of several elements at once (erase_all, erase_if, erase_positions) hash every key again.
+     *        A lookup by another key type (see KeyComparableWith) uses the fingerprints if hash_ accepts it.
+     *
+     * @tparam key_  Type of the key.
+     * @tparam hash_ Hash function of the key.
+     */
+    template<class key_, class hash_ = std::hash<key_>>
+    class fingerprint_index {
+        public:
+            /** @cond */
+            using key_type = key_;
+            using size_type = size_t;
+            using fingerprints_type = std::vector<uint8_t>;
+            /** @endcond */
+
+            static constexpr bool enabled = false;
+            template<class K>
+            static constexpr bool filters = std::is_invocable_r_v<size_t, const hash_&, const K&>;
+
+            template<class map_>
+            void inserted(const map_& map, size_type pos, size_type count) {
+                fingerprints_.insert(fingerprints_.begin() + static_cast<std::ptrdiff_t>(pos), count, 0);
+                for (size_type i = pos; i < pos + count; ++i) {
+                    fingerprints_[i] = fingerprint(map.data()[i].first);
+                }
+            }
+
+            template<class map_>
+            void erasing(const map_&, size_type pos, size_type count) {
+                auto first = fingerprints_.begin() + static_cast<std::ptrdiff_t>(pos);
+                fingerprints_.erase(first, first + static_cast<std::ptrdiff_t>(count));
+            }
+
+            template<class map_>
+            void moved(const map_&, size_type from, size_type to) {
+                auto base = fingerprints_.begin();
+                if (from < to) {
+                    std::rotate(base + from, base + from + 1, base + to + 1);
+                }
+                else {
+                    std::rotate(base + to, base + from, base + from + 1);
+                }
+            }
+
+            template<class map_>
+            void swapped(const map_&, size_type a, size_type b) { std::swap(fingerprints_[a], fingerprints_[b]); }
+
+            template<class map_>
+            void key_changing(const map_&, size_type pos, const key_type& new_key) { fingerprints_[pos] = fingerprint(new_key); }
+
+            void cleared() { fingerprints_.clear(); }
+
+            /**
+             * @brief Calls f(pos) for every position in [first, last) whose fingerprint matches key, in ascending order, until f returns false.
+             *
+             * @param key    Key to look for.
+             * @param first  First position scanned.
+             * @param last   Position after the last one scanned.
+             * @param f      Function called with the position of every candidate, which must still compare its key.
+             * @return bool  false if f stopped the scan.
+             */
+            template<class K, class F>
+            requires filters<K>
+            bool for_each_candidate(const K& key, size_type first, size_type last, F&& f) const {
+                return simd::for_each_match(fingerprints_.data() + first, last - first, fingerprint(key),
+                                            [&](size_type i) { return f(first + i); });
+            }
+
+            /**
+             * @brief Fingerprint of a key: the top byte of its mixed hash.
+             */
+            template<class K>
+            static uint8_t fingerprint(const K& key) {
+                // Mixing first, so that identity hashes do not give every key the same fingerprint.
+                return static_cast<uint8_t>((static_cast<uint64_t>(hash_()(key)) * 0x9e3779b97f4a7c15ull) >> 56);
+            }
+
+            /**
+             * @brief Fingerprints of the elements, in the same order.
+             */
+            const fingerprints_type& fingerprints() const { return fingerprints_; }
+
+        private:
+            fingerprints_type fingerprints_;
+    };
+
+    /**
+     * @brief Keys with a total order, that a sorted_index can keep sorted with std::less.
+     */
+    template<class T>
+    concept OrderedKeyable = Keyable<T> && std::totally_ordered<T>;
+
+    /**
+     * @brief Index policy that keeps the positions of the elements sorted by key, equal keys by position.\n
+     *        The elements keep their insertion order: the index is a permutation of their positions, which gives
+     *        ordered iteration (vectormap::sorted_view) and range queries (lower_bound, upper_bound, equal_range,
+     *        vectormap::range_view) in O(log n). The key lookups use equal_range too, so keys that are equivalent
+     *        for compare_ must also be equal.
+     *
+     *        Inserting an element costs O(log n) comparisons plus shifting O(n) positions, as the vectormap
+     *        shifts the elements. Inserting several elements at once sorts them and merges them in one pass.
+     *        Other key types are looked up without conversion when compare_ is transparent (e.g. std::less<>);
+     *        otherwise they are converted to key_ first.
+     *
+     * @tparam key_     Type of the key.
+     * @tparam compare_ Strict weak order of the keys.
+     */
+    template<Keyable key_, class compare_ = std::less<key_>>
+    requires std::strict_weak_order<const compare_&, const key_&, const key_&>
+    class sorted_index {
+        public:
+            /** @cond */
+            using key_type = key_;
+            using size_type = size_t;
+            using positions_type = std::vector<size_type>;
+            using const_iterator = typename positions_type::const_iterator;
+            using range_type = std::ranges::subrange<const_iterator>;
+            /** @endcond */
+
+            static constexpr bool enabled = false;
+            static constexpr bool ordered = true;
+            static constexpr bool transparent = requires { typename compare_::is_transparent; };
+
+            template<class map_>
+            void inserted(const map_& map, size_type pos, size_type count) {
+                if (pos + count < map.size()) {
+                    for (size_type& elem : order_) {
+                        elem = elem >= pos ? elem + count : elem;
+                    }
+                }
+                if (count == 1) {
+                    insert_(map, map.data()[pos].first, pos);
+                }
+                else {
+                    auto middle = order_.insert(order_.end(), count, 0);
+                    std::iota(middle, order_.end(), pos);
+                    std::stable_sort(middle, order_.end(), [&](size_type a, size_type b) { return compare_()(map.data()[a].first, map.data()[b].first); });
+                    std::inplace_merge(order_.begin(), middle, order_.end(), [&](size_type a, size_type b) { return less_(map, a, b); });
+                }
+            }
+
+            template<class map_>
+            void erasing(const map_& map, size_type pos, size_type count) {
+                if ((count == 1) && (pos + 1 == map.size())) {
+                    order_.erase(find_(map, pos));
+                }
+                else {
+                    std::erase_if(order_, [&](size_type elem) { return (elem >= pos) && (elem < pos + count); });
+                    for (size_type& elem : order_) {
+                        elem = elem >= pos + count ? elem - count : elem;
+                    }
+                }
+            }
+
+            template<class map_>
+            void moved(const map_& map, size_type from, size_type to) {
+                order_.erase(std::find(order_.begin(), order_.end(), from));
+                for (size_type& elem : order_) {
+                    if ((from < to) && (elem > from) && (elem <= to)) {
+                        --elem;
+                    }
+                    else if ((to < from) && (elem >= to) && (elem < from)) {
+                        ++elem;
+                    }
+                }
+                insert_(map, map.data()[to].first, to);
+            }
+
+            template<class map_>
+            void swapped(const map_& map, size_type a, size_type b) {
+                const key_type& key_a = map.data()[a].first;
+                const key_type& key_b = map.data()[b].first;
+                if (compare_()(key_a, key_b) || compare_()(key_b, key_a)) {
+                    order_.erase(std::find(order_.begin(), order_.end(), a));
+                    order_.erase(std::find(order_.begin(), order_.end(), b));
+                    insert_(map, key_a, a);
+                    insert_(map, key_b, b);
+                }
+            }
+
+            template<class map_>
+            void key_changing(const map_& map, size_type pos, const key_type& new_key) {
+                const key_type& old_key = map.data()[pos].first;
+                if (compare_()(old_key, new_key) || compare_()(new_key, old_key)) {
+                    order_.erase(find_(map, pos));
+                    insert_(map, new_key, pos);
+                }
+            }
+
+            void cleared() { order_.clear(); }
+
+            /**
+             * @brief Positions of the elements, sorted by key and equal keys by position.
+             */
+            const positions_type& sorted() const { return order_; }
+
+            /**
+             * @brief First position, in sorted(), whose key is not less than key.
+             *
+             * @param map             vectormap that owns the index.
+             * @param key             Key to look for.
+             * @return const_iterator Iterator into sorted().
+             */
+            template<class map_, class K>
+            requires std::same_as<K, key_type> || transparent || std::constructible_from<key_type, const K&>
+            const_iterator lower_bound(const map_& map, const K& key) const {
+                if constexpr (std::same_as<K, key_type> || transparent) {
+                    return std::lower_bound(order_.begin(), order_.end(), key, [&](size_type elem, const K& k) { return compare_()(map.data()[elem].first, k); });
+                }
+                else {
+                    return lower_bound(map, key_type(key));
+                }
+            }
+
+            /**
+             * @brief First position, in sorted(), whose key is greater than key.
+             */
+            template<class map_, class K>
+            requires std::same_as<K, key_type> || transparent || std::constructible_from<key_type, const K&>
+            const_iterator upper_bound(const map_& map, const K& key) const {
+                if constexpr (std::same_as<K, key_type> || transparent) {
+                    return std::upper_bound(order_.begin(), order_.end(), key, [&](const K& k, size_type elem) { return compare_()(k, map.data()[elem].first); });
+                }
+                else {
+                    return upper_bound(map, key_type(key));
+                }
+            }
+
+            /**
+             * @brief Ascending positions holding a key equivalent to key.
+             */
+            template<class map_, class K>
+            requires std::same_as<K, key_type> || transparent || std::constructible_from<key_type, const K&>
+            range_type equal_range(const map_& map, const K& key) const {
+                if constexpr (std::same_as<K, key_type> || transparent) {
+                    return range_type(lower_bound(map, key), upper_bound(map, key));
+                }
+                else {
+                    return equal_range(map, key_type(key));
+                }
+            }
+
+        private:
+            positions_type order_;
+
+            template<class map_>
+            static bool less_(const map_& map, size_type a, size_type b) {
+                const key_type& key_a = map.data()[a].first;
+                const key_type& key_b = map.data()[b].first;
+                return compare_()(key_a, key_b) || (!compare_()(key_b, key_a) && (a < b));
+            }
+
+            template<class map_>
+            const_iterator find_(const map_& map, size_type pos) const {
+                return locate_(map, map.data()[pos].first, pos);
+            }
+
+            // Where the element at pos is, or goes, if its key is key.
+            template<class map_>
+            const_iterator locate_(const map_& map, const key_type& key, size_type pos) const {
+                return std::lower_bound(order_.begin(), order_.end(), pos, [&](size_type elem, size_type p) {
+                    const key_type& other = map.data()[elem].first;
+                    return compare_()(other, key) || (!compare_()(key, other) && (elem < p));
+                });
+            }
+
+            template<class map_>
+            void insert_(const map_& map, const key_type& key, size_type pos) {
+                order_.insert(locate_(map, key, pos), pos);
+            }
+    };
+
+    /**
+     * @brief Index policy that gives every element a stable_handle, which keeps identifying it through insertions, erasures,
+     *        moves, swaps and reallocations until the element is erased.
+
+     *        The handles are slots of an indirection table that holds the position of their element, so they resolve in O(1)
+     *        (see vectormap::resolve). Erasing an element frees its slot and bumps its generation, so the stale handles
+     *        resolve to nothing even after the slot is reused.
+     *
+     *        Appending elements costs O(1) per element. Inserting, erasing or moving in the middle updates the slots
+     *        of the elements behind the modified one, which the vectormap has to shift anyway.
+     *        The table takes three words per element.
+     *
+     * @tparam indexing_ Index policy whose lookups the vectormap keeps using (see no_index).
+     */
+    template<class indexing_ = no_index>
+    class stable_index : public indexing_ {
+        public:
+            /** @cond */
+            using size_type = size_t;
+            using handle_type = stable_handle;
+            /** @endcond */
+
+            static constexpr size_type npos = std::numeric_limits<size_type>::max();
+            static constexpr bool stable = true;
+
+            template<class map_>
+            void inserted(const map_& map, size_type pos, size_type count) {
+                indexing_::inserted(map, pos, count);
+                handles_.insert(handles_.begin() + pos, count, 0);
+                for (size_type i = pos; i < pos + count; ++i) {
+                    handles_[i] = acquire_();
+                }
+                renumber_(pos, handles_.size());
+            }
+
+            template<class map_>
+            void erasing(const map_& map, size_type pos, size_type count) {
+                indexing_::erasing(map, pos, count);
+                for (size_type i = pos; i < pos + count; ++i) {
+                    release_(handles_[i]);
+                }
+                handles_.erase(handles_.begin() + pos, handles_.begin() + pos + count);
+                renumber_(pos, handles_.size());
+            }
+
+            template<class map_>
+            void moved(const map_& map, size_type from, size_type to) {
+                indexing_::moved(map, from, to);
+                if (from < to) {
+                    std::rotate(handles_.begin() + from, handles_.begin() + from + 1, handles_.begin() + to + 1);
+                    renumber_(from, to + 1);
+                }
+                else {
+                    std::rotate(handles_.begin() + to, handles_.begin() + from, handles_.begin() + from + 1);
+                    renumber_(to, from + 1);
+                }
+            }
+
+            template<class map_>
+            void swapped(const map_& map, size_type a, size_type b) {
+                indexing_::swapped(map, a, b);
+                std::swap(handles_[a], handles_[b]);
+                slots_[handles_[a]].pos = a;
+                slots_[handles_[b]].pos = b;
+            }
+
+            void cleared() {
+                indexing_::cleared();
+                for (size_type slot : handles_) {
+                    release_(slot);
+                }
+                handles_.clear();
+            }
+
+            template<class map_>
+            void compacted(const map_& map, const std::vector<bool>& removed) {
+                indexing_::cleared();
+                indexing_::inserted(map, 0, map.size());
+                size_type kept = 0;
+                for (size_type i = 0; i < handles_.size(); ++i) {
+                    if (removed[i]) {
+                        release_(handles_[i]);
+                    }
+                    else {
+                        handles_[kept++] = handles_[i];
+                    }
+                }
+                handles_.resize(kept);
+                renumber_(0, kept);
+            }
+
+            /**
+             * @brief Handle of the element at a position.
+             *
+             * @param pos           Position of the element, smaller than the size of the vectormap.
+             * @return handle_type  Handle that identifies the element until it is erased.
+             */
+            handle_type handle(size_type pos) const { return {handles_[pos], slots_[handles_[pos]].generation}; }
+
+            /**
+             * @brief Current position of the element identified by a handle.
+             *
+             * @param handle      Handle returned by handle().
+             * @return size_type  Position of the element, npos if it has been erased or the handle is null.
+             */
+            size_type pos(const handle_type& handle) const {
+                return (handle.slot < slots_.size()) && (slots_[handle.slot].generation == handle.generation) ? slots_[handle.slot].pos : npos;
+            }
+
+        private:
+            struct slot_ {
+                size_type pos;
+                size_type generation;
+            };
+
+            std::vector<slot_> slots_;              // Position and generation of every handle, npos if the slot is free.
+            std::vector<size_type> handles_;        // Slot of the element at every position.
+            std::vector<size_type> free_;           // Free slots, reused last in first out.
+
+            size_type acquire_() {
+                if (free_.empty()) {
+                    slots_.push_back({npos, 0});
+                    return slots_.size() - 1;
+                }
+                size_type slot = free_.back();
+                free_.pop_back();
+                return slot;
+            }
+
+            void release_(size_type slot) {
+                slots_[slot].pos = npos;
+                ++slots_[slot].generation;
+                free_.push_back(slot);
+            }
+
+            void renumber_(size_type first, size_type last) {
+                for (size_type i = first; i < last; ++i) {
+                    slots_[handles_[i]].pos = i;
+                }
+            }
+    };
+
+    /**
+     * @brief vectormap with a hash index on its keys.
+     *
+     * @tparam key_   Type of the key.
+     * @tparam value_ Type of the value.
+     * @tparam delta_ Number of new elements to allocate every time the container growths.
+     * @tparam hash_  Hash function of the key.
+     * @tparam equal_ Equality comparison of the key.
+     * @tparam alloc_ Allocator of the elements.
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100,
+             class hash_ = std::hash<key_>, class equal_ = std::equal_to<key_>, class alloc_ = std::allocator<std::pair<const key_, value_>>>
+    using indexed_vectormap = vectormap<key_, value_, delta_, hash_index<key_, hash_, equal_>, delta_growth, alloc_>;
+
+    namespace pmr {
+        /**
+         * @brief indexed_vectormap whose elements are allocated from a std::pmr::memory_resource.\n
+         *        The index itself keeps using the default allocator.
+         */
+        template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100,
+                 class hash_ = std::hash<key_>, class equal_ = std::equal_to<key_>>
+        using indexed_vectormap = com::indexed_vectormap<key_, value_, delta_, hash_, equal_, std::pmr::polymorphic_allocator<std::pair<const key_, value_>>>;
+    }
+
+    /**
+     * @brief vectormap that filters its key scans with a fingerprint of every key (see fingerprint_index).
+     *
+     * @tparam key_   Type of the key.
+     * @tparam value_ Type of the value.
+     * @tparam delta_ Number of new elements to allocate every time the container growths.
+     * @tparam hash_  Hash function of the key.
+     * @tparam alloc_ Allocator of the elements.
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100,
+             class hash_ = std::hash<key_>, class alloc_ = std::allocator<std::pair<const key_, value_>>>
+    using fingerprint_vectormap = vectormap<key_, value_, delta_, fingerprint_index<key_, hash_>, delta_growth, alloc_>;
+
+    /**
+     * @brief vectormap in insertion order that can also be walked and queried in key order (see sorted_index).
+     *
+     * @tparam key_     Type of the key.
+     * @tparam value_   Type of the value.
+     * @tparam delta_   Number of new elements to allocate every time the container growths.
+     * @tparam compare_ Strict weak order of the keys.
+     * @tparam alloc_   Allocator of the elements.
+     */
+    template<OrderedKeyable key_, std::default_initializable value_, size_t delta_ = 100,
+             class compare_ = std::less<key_>, class alloc_ = std::allocator<std::pair<const key_, value_>>>
+    using sorted_vectormap = vectormap<key_, value_, delta_, sorted_index<key_, compare_>, delta_growth, alloc_>;
+
+    /**
+     * @brief vectormap whose elements can be referred to by stable handles (see stable_index).\n
+     *        It grows geometrically, so that streamed appends (see vectormap::append_batch) run in amortized constant time.
+     *
+     * @tparam key_      Type of the key.
+     * @tparam value_    Type of the value.
+     * @tparam delta_    Number of new elements to allocate every time the container growths.
+     * @tparam indexing_ Index policy used for the key lookups.
+     * @tparam alloc_    Allocator of the elements.
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100,
+             class indexing_ = no_index, class alloc_ = std::allocator<std::pair<const key_, value_>>>
+    using stable_vectormap = vectormap<key_, value_, delta_, stable_index<indexing_>, geometric_growth<2>, alloc_>;
+}
+#endif
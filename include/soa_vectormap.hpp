@@ -0,0 +1,747 @@
+#ifndef __SOAVECTORMAP_H__
+#define __SOAVECTORMAP_H__
+
+#include "vectormap.hpp"
+
+#include <cstring>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace com {
+    /**
+     * @brief vectormap that stores the keys and the values in two separate arrays (structure of arrays).\n
+     *        Key lookups only walk the key array, and the keys are scanned several at a time
+     *        when they are integral or enumerations, whatever the size of the values.
+     *        values() walks the values without touching the keys.
+     *
+     *        The interface is the one of vectormap, but the elements are no longer stored as pairs:
+     *        the iterators yield a pair of references (first: const key, second: value) by value,
+     *        and there is no data(); use keys() and values() instead.
+     *
+     * @tparam key_    Type of the key.
+     * @tparam value_  Type of the value.
+     * @tparam delta_  Number of new elements to allocate every time the container growths.
+     * @tparam growth_ Policy that computes the new capacity when the container growths (see delta_growth).
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100, class growth_ = delta_growth>
+    class soa_vectormap
+    {
+        public:
+            template<bool const_> class Iterator;
+
+            /** @cond */
+            using key_type = key_;
+            using mapped_type = value_;
+            using value_type = std::pair<const key_type, mapped_type>;
+            using key_allocator_type = std::allocator<key_type>;
+            using mapped_allocator_type = std::allocator<mapped_type>;
+            using reference = std::pair<const key_type&, mapped_type&>;
+            using const_reference = std::pair<const key_type&, const mapped_type&>;
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+            using reverse_iterator = std::reverse_iterator<iterator>;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+            using size_type = size_t;
+            using iterator_pos = std::pair<iterator, size_type>;
+            using growth_type = growth_;
+
+            static constexpr size_type npos = std::numeric_limits<size_type>::max();
+            static constexpr bool positional_overloads = !(std::is_convertible_v<key_type, size_type> && std::is_convertible_v<size_type, key_type>);
+            /** @endcond */
+
+            /**
+             * @brief Random access iterator over the elements.\n
+             *        Like std::vector<bool>, it dereferences to a proxy: a pair of references to the key and the value.
+             *        Its iterator_concept is random access, but its iterator_category is only input, since the
+             *        reference is not a real reference. The const iterator does not satisfy std::indirectly_readable
+             *        before C++23, which gives std::pair a common reference with its proxy.
+             */
+            template<bool const_>
+            class Iterator {
+                public:
+                    using mapped_pointer = std::conditional_t<const_, const mapped_type*, mapped_type*>;
+                    using iterator_category = std::input_iterator_tag;
+                    using iterator_concept = std::random_access_iterator_tag;
+                    using value_type = typename soa_vectormap::value_type;
+                    using difference_type = std::ptrdiff_t;
+                    using reference = std::conditional_t<const_, const_reference, typename soa_vectormap::reference>;
+
+                    struct pointer {
+                        reference ref;
+                        const reference* operator->() const { return &ref; }
+                    };
+
+                    Iterator(const key_type* key = nullptr, mapped_pointer value = nullptr) : key_ptr_(key), value_ptr_(value) {}
+                    reference operator*() const { return reference(*key_ptr_, *value_ptr_); }
+                    pointer operator->() const { return pointer{**this}; }
+                    reference operator[](difference_type n) const { return *(*this + n); }
+                    Iterator operator+(difference_type n) const { return Iterator(key_ptr_ + n, value_ptr_ + n); }
+                    Iterator operator-(difference_type n) const { return Iterator(key_ptr_ - n, value_ptr_ - n); }
+                    friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+                    difference_type operator-(const Iterator& other) const { return key_ptr_ - other.key_ptr_; }
+                    Iterator& operator+=(difference_type n) { key_ptr_ += n; value_ptr_ += n; return *this; }
+                    Iterator& operator-=(difference_type n) { key_ptr_ -= n; value_ptr_ -= n; return *this; }
+                    Iterator& operator++() { ++key_ptr_; ++value_ptr_; return *this; }
+                    Iterator operator++(int) { Iterator tmp = *this; ++*this; return tmp; }
+                    Iterator& operator--() { --key_ptr_; --value_ptr_; return *this; }
+                    Iterator operator--(int) { Iterator tmp = *this; --*this; return tmp; }
+                    bool operator==(const Iterator& other) const { return key_ptr_ == other.key_ptr_; }
+                    auto operator<=>(const Iterator& other) const { return key_ptr_ <=> other.key_ptr_; }
+
+                    operator Iterator<true>() const requires (!const_) { return Iterator<true>(key_ptr_, value_ptr_); }
+
+                private:
+                    const key_type* key_ptr_;
+                    mapped_pointer value_ptr_;
+            };
+
+            /** @name Constructors */
+            /** @{ */
+            soa_vectormap() = default;
+            soa_vectormap(const std::initializer_list<value_type>& il);
+            soa_vectormap(const soa_vectormap& other);
+            soa_vectormap(soa_vectormap&& other) noexcept;
+            /** @} */
+
+            // Destructor
+            ~soa_vectormap();
+
+            /** @name Element insertion */
+            /** @{ */
+            /**
+             * @brief Constructs an element at a given position.
+             *
+             * @param pos        Position of the new element.
+             * @param key        Key of the new element.
+             * @param args       Arguments forwarded to the constructor of the value.
+             * @return iterator  Iterator pointing to the added element, end() if pos is out of range.
+             */
+            template<class K, class... Args>
+            iterator emplace(const size_type pos, K&& key, Args&&... args);
+            template<class K, class... Args>
+            iterator emplace_back(K&& key, Args&&... args) { return emplace(size_, std::forward<K>(key), std::forward<Args>(args)...); }
+            template<class K, class... Args>
+            iterator emplace_front(K&& key, Args&&... args) { return emplace(0, std::forward<K>(key), std::forward<Args>(args)...); }
+            iterator insert(const value_type& val, const size_type pos) { return emplace(pos, val.first, val.second); }
+            iterator insert(value_type&& val, const size_type pos) { return emplace(pos, val.first, std::move(val.second)); }
+            iterator insert(const key_type& key, const mapped_type& val, const size_type pos) { return emplace(pos, key, val); }
+            iterator insert(key_type&& key, mapped_type&& val, const size_type pos) { return emplace(pos, std::move(key), std::move(val)); }
+            iterator insert(const std::initializer_list<value_type>& il, const size_type pos);
+            iterator insert(const soa_vectormap& map, const size_type pos);
+            iterator push_back(const value_type& val) { return insert(val, size_); }
+            iterator push_back(value_type&& val) { return insert(std::move(val), size_); }
+            iterator push_back(const key_type& key, const mapped_type& val) { return insert(key, val, size_); }
+            iterator push_back(key_type&& key, mapped_type&& val) { return insert(std::move(key), std::move(val), size_); }
+            iterator push_back(const std::initializer_list<value_type>& il) { return insert(il, size_); }
+            iterator push_back(const soa_vectormap& map) { return insert(map, size_); }
+            iterator push_front(const value_type& val) { return insert(val, 0); }
+            iterator push_front(value_type&& val) { return insert(std::move(val), 0); }
+            iterator push_front(const key_type& key, const mapped_type& val) { return insert(key, val, 0); }
+            iterator push_front(key_type&& key, mapped_type&& val) { return insert(std::move(key), std::move(val), 0); }
+            iterator push_front(const std::initializer_list<value_type>& il) { return insert(il, 0); }
+            iterator push_front(const soa_vectormap& map) { return insert(map, 0); }
+            /** @} */
+
+            /** @name Element access */
+            /** @{ */
+            iterator get(const size_type pos) requires positional_overloads { return get_at(pos); }
+            std::vector<iterator_pos> get(const key_type& key, size_type ordinal = 1, size_type number = 1);
+            std::vector<iterator_pos> get_all(const key_type& key);
+            mapped_type& get_value(const size_type& pos) requires positional_overloads { return get_value_at(pos); }
+            const mapped_type& get_value(const size_type& pos) const requires positional_overloads { return get_value_at(pos); }
+            std::vector<mapped_type> get_value(const key_type& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<mapped_type> get_all_values(const key_type& key) const;
+            const key_type& get_key(const size_type& pos) const { return get_key_at(pos); }
+            std::vector<size_type> get_pos(const key_type& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<size_type> get_all_pos(const key_type& key) const;
+            iterator get_at(const size_type pos) { return pos < size_ ? begin() + pos : end(); }
+            mapped_type& get_value_at(const size_type pos) { return pos < size_ ? values_[pos] : discarded_value<mapped_type>(); }
+            const mapped_type& get_value_at(const size_type pos) const { return pos < size_ ? values_[pos] : void_mapped_type_; }
+            const key_type& get_key_at(const size_type pos) const { return pos < size_ ? keys_[pos] : void_key_type_; }
+            reference operator[](const size_type pos) { return reference(keys_[pos], values_[pos]); }
+            const_reference operator[](const size_type pos) const { return const_reference(keys_[pos], values_[pos]); }
+            iterator find(const key_type& key) { return find_nth(key, 1); }
+            const_iterator find(const key_type& key) const { return find_nth(key, 1); }
+            iterator find_nth(const key_type& key, size_type ordinal) { size_type pos = find_pos_(key, ordinal); return pos != npos ? begin() + pos : end(); }
+            const_iterator find_nth(const key_type& key, size_type ordinal) const { size_type pos = find_pos_(key, ordinal); return pos != npos ? begin() + pos : end(); }
+            size_type count(const key_type& key) const;
+            bool contains(const key_type& key) const { return find_pos_(key, 1) != npos; }
+            /**
+             * @brief Contiguous array of the keys, in insertion order.
+             */
+            std::span<const key_type> keys() const { return std::span<const key_type>(keys_, size_); }
+            /**
+             * @brief Contiguous array of the values, in insertion order.
+             */
+            std::span<mapped_type> values() { return std::span<mapped_type>(values_, size_); }
+            std::span<const mapped_type> values() const { return std::span<const mapped_type>(values_, size_); }
+            /** @} */
+
+            /** @name  Element modification */
+            /** @{ */
+            void set(const value_type& new_value, const size_type pos) requires positional_overloads { set_at(new_value, pos); }
+            void set(const value_type& new_value, const key_type& key, size_type ordinal = 1);
+            void set_value(const mapped_type& new_mapped_value, const size_type pos) requires positional_overloads { set_value_at(new_mapped_value, pos); }
+            void set_value(const mapped_type& new_mapped_value, const key_type& key, size_type ordinal = 1);
+            void set_key(const key_type& new_key, const size_type pos) requires positional_overloads { set_key_at(new_key, pos); }
+            void set_key(const key_type& new_key, const key_type& key, size_type ordinal = 1);
+            void set_at(const value_type& new_value, const size_type pos);
+            void set_value_at(const mapped_type& new_mapped_value, const size_type pos) { if (pos < size_) values_[pos] = new_mapped_value; }
+            void set_key_at(const key_type& new_key, const size_type pos) { if (pos < size_) keys_[pos] = new_key; }
+            /** @} */
+
+            /** @name  Element management */
+            /** @{ */
+            void clear();
+            void erase(const size_type pos) requires positional_overloads { erase_at(pos); }
+            void erase(const key_type& key);
+            void erase_at(const size_type pos);
+            void erase(const std::initializer_list<size_type>& il) { erase_positions(std::span<const size_type>(il.begin(), il.size())); }
+            size_type erase_all(const key_type& key) { return compact_([&](size_type i) { return keys_[i] == key; }); }
+            /**
+             * @brief Erases every element for which pred returns true, in a single pass (see vectormap::erase_if).
+             *
+             * @param pred         Predicate called once per element, in order, with a const_reference to it.
+             * @return size_type   Number of erased elements.
+             */
+            template<class P>
+            size_type erase_if(P pred) { return compact_([&](size_type i) { return static_cast<bool>(pred(const_reference(keys_[i], values_[i]))); }); }
+            size_type erase_positions(std::span<const size_type> positions);
+            void move(const size_type from, const size_type to);
+            void swap(const size_type from, const size_type to);
+            /** @} */
+
+            /** @name  Memory manipulation */
+            /** @{ */
+            size_type size() const { return size_; }
+            size_type capacity() const { return capacity_; }
+            bool is_empty() const { return size_ == 0; }
+            bool reserve(size_type min_capacity);
+            bool shrink() { return resize(size_); };
+            bool resize(size_type new_capacity);
+            /** @} */
+
+            /** @name  Operators */
+            /** @{ */
+            soa_vectormap& operator=(const soa_vectormap& other);
+            soa_vectormap& operator=(soa_vectormap&& other) noexcept;
+            /** @} */
+
+            /** @name  Iterators */
+            /** @{ */
+            iterator begin() { return iterator(keys_, values_); }
+            iterator end() { return iterator(keys_ + size_, values_ + size_); }
+            const_iterator begin() const { return const_iterator(keys_, values_); }
+            const_iterator end() const { return const_iterator(keys_ + size_, values_ + size_); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+            reverse_iterator rbegin() { return reverse_iterator(end()); }
+            reverse_iterator rend() { return reverse_iterator(begin()); }
+            const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+            const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+            const_reverse_iterator crbegin() const { return rbegin(); }
+            const_reverse_iterator crend() const { return rend(); }
+            /** @} */
+
+        private:
+            [[no_unique_address]] key_allocator_type key_allocator_;
+            [[no_unique_address]] mapped_allocator_type mapped_allocator_;
+            size_type size_ = 0;
+            size_type capacity_ = 0;
+            key_type* keys_ = nullptr;
+            mapped_type* values_ = nullptr;
+            static inline const mapped_type void_mapped_type_{};
+            static inline const key_type void_key_type_{};
+
+            // Opens room for length elements at from, which are not counted in size_ until they are built.
+            bool gap_(size_type from, size_type length);
+            /**
+             * @brief Builds length elements at from, the i-th from key(i) and value(i).\n
+             *        If one of them throws, the elements built are destroyed and the gap is closed again.
+             */
+            template<class K, class V>
+            bool insert_n_(size_type from, size_type length, K&& key, V&& value);
+            void adopt_(size_type new_capacity, size_type from, size_type length);
+            void deallocate_();
+            size_type find_pos_(const key_type& key, size_type ordinal) const;
+
+            template<class F>
+            size_type compact_(F&& remove);
+
+            template<class F>
+            void for_each_pos_(const key_type& key, F&& f) const;
+
+            // Moves n objects from src to dst, which may overlap, leaving src uninitialized.
+            template<class T, class allocator_>
+            static void relocate_(allocator_& allocator, T* dst, T* src, size_type n);
+    };
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    soa_vectormap<key_, value_, delta_, growth_>::soa_vectormap(const std::initializer_list<value_type>& il) {
+        try {
+            insert(il, 0);
+        }
+        catch (...) {
+            deallocate_();
+            throw;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    soa_vectormap<key_, value_, delta_, growth_>::soa_vectormap(const soa_vectormap& other) {
+        try {
+            insert(other, 0);
+        }
+        catch (...) {
+            deallocate_();
+            throw;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    soa_vectormap<key_, value_, delta_, growth_>::soa_vectormap(soa_vectormap&& other) noexcept
+        : size_(std::exchange(other.size_, 0)), capacity_(std::exchange(other.capacity_, 0)),
+          keys_(std::exchange(other.keys_, nullptr)), values_(std::exchange(other.values_, nullptr)) {}
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    soa_vectormap<key_, value_, delta_, growth_>::~soa_vectormap() {
+        clear();
+        deallocate_();
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    template<class K, class... Args>
+    typename soa_vectormap<key_, value_, delta_, growth_>::iterator soa_vectormap<key_, value_, delta_, growth_>::emplace(const size_type pos, K&& key, Args&&... args) {
+        if (pos > size_) {
+            return end();
+        }
+
+        // Build the element first, the arguments may refer to the elements of the soa_vectormap.
+        key_type new_key(std::forward<K>(key));
+        mapped_type new_value(std::forward<Args>(args)...);
+
+        if (!insert_n_(pos, 1, [&](size_type) -> key_type&& { return std::move(new_key); }, [&](size_type) -> mapped_type&& { return std::move(new_value); })) {
+            return end();
+        }
+        return begin() + pos;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename soa_vectormap<key_, value_, delta_, growth_>::iterator soa_vectormap<key_, value_, delta_, growth_>::insert(const std::initializer_list<value_type>& il, const size_type pos) {
+        const value_type* elems = il.begin();
+        if (!insert_n_(pos, il.size(), [&](size_type i) -> const key_type& { return elems[i].first; }, [&](size_type i) -> const mapped_type& { return elems[i].second; })) {
+            return end();
+        }
+        return begin() + pos;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename soa_vectormap<key_, value_, delta_, growth_>::iterator soa_vectormap<key_, value_, delta_, growth_>::insert(const soa_vectormap& map, const size_type pos) {
+        if ((&map == this) || !insert_n_(pos, map.size_, [&](size_type i) -> const key_type& { return map.keys_[i]; }, [&](size_type i) -> const mapped_type& { return map.values_[i]; })) {
+            return end();
+        }
+        return begin() + pos;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename soa_vectormap<key_, value_, delta_, growth_>::iterator_pos> soa_vectormap<key_, value_, delta_, growth_>::get(const key_type& key, size_type ordinal, size_type number) {
+        std::vector<iterator_pos> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order >= ordinal) {
+                out.push_back(std::make_pair(begin() + i, i));
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename soa_vectormap<key_, value_, delta_, growth_>::iterator_pos> soa_vectormap<key_, value_, delta_, growth_>::get_all(const key_type& key) {
+        std::vector<iterator_pos> out;
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(std::make_pair(begin() + i, i));
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename soa_vectormap<key_, value_, delta_, growth_>::mapped_type> soa_vectormap<key_, value_, delta_, growth_>::get_value(const key_type& key, size_type ordinal, size_type number) const {
+        std::vector<mapped_type> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order >= ordinal) {
+                out.push_back(values_[i]);
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename soa_vectormap<key_, value_, delta_, growth_>::mapped_type> soa_vectormap<key_, value_, delta_, growth_>::get_all_values(const key_type& key) const {
+        std::vector<mapped_type> out;
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(values_[i]);
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename soa_vectormap<key_, value_, delta_, growth_>::size_type> soa_vectormap<key_, value_, delta_, growth_>::get_pos(const key_type& key, size_type ordinal, size_type number) const {
+        std::vector<size_type> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order >= ordinal) {
+                out.push_back(i);
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename soa_vectormap<key_, value_, delta_, growth_>::size_type> soa_vectormap<key_, value_, delta_, growth_>::get_all_pos(const key_type& key) const {
+        std::vector<size_type> out;
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(i);
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename soa_vectormap<key_, value_, delta_, growth_>::size_type soa_vectormap<key_, value_, delta_, growth_>::count(const key_type& key) const {
+        size_type out = 0;
+        for_each_pos_(key, [&](size_type) {
+            ++out;
+            return true;
+        });
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::set(const value_type& new_value, const key_type& key, size_type ordinal) {
+        set_at(new_value, find_pos_(key, ordinal));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::set_value(const mapped_type& new_mapped_value, const key_type& key, size_type ordinal) {
+        size_type pos = find_pos_(key, ordinal);
+        if (pos != npos) {
+            values_[pos] = new_mapped_value;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::set_key(const key_type& new_key, const key_type& key, size_type ordinal) {
+        set_key_at(new_key, find_pos_(key, ordinal));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::set_at(const value_type& new_value, const size_type pos) {
+        if (pos < size_) {
+            keys_[pos] = new_value.first;
+            values_[pos] = new_value.second;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::clear() {
+        for (size_type i = 0; i < size_; ++i) {
+            std::allocator_traits<key_allocator_type>::destroy(key_allocator_, keys_ + i);
+            std::allocator_traits<mapped_allocator_type>::destroy(mapped_allocator_, values_ + i);
+        }
+        size_ = 0;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::erase(const key_type& key) {
+        erase_at(find_pos_(key, 1));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::erase_at(const size_type pos) {
+        if (pos < size_) {
+            std::allocator_traits<key_allocator_type>::destroy(key_allocator_, keys_ + pos);
+            std::allocator_traits<mapped_allocator_type>::destroy(mapped_allocator_, values_ + pos);
+            relocate_(key_allocator_, keys_ + pos, keys_ + pos + 1, size_ - pos - 1);
+            relocate_(mapped_allocator_, values_ + pos, values_ + pos + 1, size_ - pos - 1);
+            --size_;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename soa_vectormap<key_, value_, delta_, growth_>::size_type soa_vectormap<key_, value_, delta_, growth_>::erase_positions(std::span<const size_type> positions) {
+        std::vector<size_type> sorted;
+        if (!std::is_sorted(positions.begin(), positions.end())) {
+            sorted.assign(positions.begin(), positions.end());
+            std::sort(sorted.begin(), sorted.end());
+            positions = sorted;
+        }
+
+        auto it = positions.begin();
+        return compact_([&](size_type i) {
+            while ((it != positions.end()) && (*it < i)) {
+                ++it;
+            }
+            return (it != positions.end()) && (*it == i);
+        });
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::move(const size_type from, const size_type to) {
+        if ((from < size_) && (to < size_) && (from != to)) {
+            if (from < to) {
+                std::rotate(keys_ + from, keys_ + from + 1, keys_ + to + 1);
+                std::rotate(values_ + from, values_ + from + 1, values_ + to + 1);
+            }
+            else {
+                std::rotate(keys_ + to, keys_ + from, keys_ + from + 1);
+                std::rotate(values_ + to, values_ + from, values_ + from + 1);
+            }
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::swap(const size_type from, const size_type to) {
+        if ((from < size_) && (to < size_)) {
+            std::swap(keys_[from], keys_[to]);
+            std::swap(values_[from], values_[to]);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    bool soa_vectormap<key_, value_, delta_, growth_>::reserve(size_type min_capacity) {
+        if (min_capacity < size_)
+            return false;
+
+        return resize(((min_capacity / delta_) + 1) * delta_);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    bool soa_vectormap<key_, value_, delta_, growth_>::resize(size_type new_capacity) {
+        if (new_capacity < size_)
+            return false;
+
+        adopt_(new_capacity, size_, 0);
+        return true;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    soa_vectormap<key_, value_, delta_, growth_>& soa_vectormap<key_, value_, delta_, growth_>::operator=(const soa_vectormap& other) {
+        if (this != &other) {
+            clear();
+            insert(other, 0);
+        }
+
+        return *this;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    soa_vectormap<key_, value_, delta_, growth_>& soa_vectormap<key_, value_, delta_, growth_>::operator=(soa_vectormap&& other) noexcept {
+        if (this != &other) {
+            clear();
+            deallocate_();
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+            keys_ = std::exchange(other.keys_, nullptr);
+            values_ = std::exchange(other.values_, nullptr);
+        }
+
+        return *this;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    bool soa_vectormap<key_, value_, delta_, growth_>::gap_(size_type from, size_type length) {
+        if (from > size_) {
+            return false;
+        }
+
+        if ((size_ + length) > capacity_) {
+            adopt_(growth_type::grow(capacity_, size_ + length, delta_), from, length);
+        }
+        else {
+            relocate_(key_allocator_, keys_ + from + length, keys_ + from, size_ - from);
+            relocate_(mapped_allocator_, values_ + from + length, values_ + from, size_ - from);
+        }
+
+        return true;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    template<class K, class V>
+    bool soa_vectormap<key_, value_, delta_, growth_>::insert_n_(size_type from, size_type length, K&& key, V&& value) {
+        if (!gap_(from, length)) {
+            return false;
+        }
+
+        size_type keys = 0;
+        size_type values = 0;
+        try {
+            for (; values < length; ++values) {
+                std::allocator_traits<key_allocator_type>::construct(key_allocator_, keys_ + from + keys, key(keys));
+                ++keys;
+                std::allocator_traits<mapped_allocator_type>::construct(mapped_allocator_, values_ + from + values, value(values));
+            }
+        }
+        catch (...) {
+            for (size_type i = 0; i < keys; ++i) {
+                std::allocator_traits<key_allocator_type>::destroy(key_allocator_, keys_ + from + i);
+            }
+            for (size_type i = 0; i < values; ++i) {
+                std::allocator_traits<mapped_allocator_type>::destroy(mapped_allocator_, values_ + from + i);
+            }
+            relocate_(key_allocator_, keys_ + from, keys_ + from + length, size_ - from);
+            relocate_(mapped_allocator_, values_ + from, values_ + from + length, size_ - from);
+            throw;
+        }
+
+        size_ += length;
+        return true;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::adopt_(size_type new_capacity, size_type from, size_type length) {
+        key_type* new_keys = std::allocator_traits<key_allocator_type>::allocate(key_allocator_, new_capacity);
+        mapped_type* new_values;
+        try {
+            new_values = std::allocator_traits<mapped_allocator_type>::allocate(mapped_allocator_, new_capacity);
+        }
+        catch (...) {
+            std::allocator_traits<key_allocator_type>::deallocate(key_allocator_, new_keys, new_capacity);
+            throw;
+        }
+
+        relocate_(key_allocator_, new_keys, keys_, from);
+        relocate_(key_allocator_, new_keys + from + length, keys_ + from, size_ - from);
+        relocate_(mapped_allocator_, new_values, values_, from);
+        relocate_(mapped_allocator_, new_values + from + length, values_ + from, size_ - from);
+
+        deallocate_();
+        keys_ = new_keys;
+        values_ = new_values;
+        capacity_ = new_capacity;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void soa_vectormap<key_, value_, delta_, growth_>::deallocate_() {
+        if (keys_ != nullptr) {
+            std::allocator_traits<key_allocator_type>::deallocate(key_allocator_, keys_, capacity_);
+            std::allocator_traits<mapped_allocator_type>::deallocate(mapped_allocator_, values_, capacity_);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    template<class T, class allocator_>
+    void soa_vectormap<key_, value_, delta_, growth_>::relocate_(allocator_& allocator, T* dst, T* src, size_type n) {
+        if ((n == 0) || (dst == src)) {
+            return;
+        }
+
+        if constexpr (is_trivially_relocatable<T>::value) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        }
+        else {
+            auto relocate_one = [&allocator](T* to, T* from) {
+                std::allocator_traits<allocator_>::construct(allocator, to, std::move_if_noexcept(*from));
+                std::allocator_traits<allocator_>::destroy(allocator, from);
+            };
+
+            if (dst < src) {
+                for (size_type i = 0; i < n; ++i) {
+                    relocate_one(dst + i, src + i);
+                }
+            }
+            else {
+                for (size_type i = n; i > 0; --i) {
+                    relocate_one(dst + i - 1, src + i - 1);
+                }
+            }
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename soa_vectormap<key_, value_, delta_, growth_>::size_type soa_vectormap<key_, value_, delta_, growth_>::find_pos_(const key_type& key, size_type ordinal) const {
+        size_type out = npos;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order++ >= ordinal) {
+                out = i;
+                return false;
+            }
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    template<class F>
+    typename soa_vectormap<key_, value_, delta_, growth_>::size_type soa_vectormap<key_, value_, delta_, growth_>::compact_(F&& remove) {
+        size_type kept = 0;
+        size_type run = 0;
+        auto keep = [&](size_type end) {
+            relocate_(key_allocator_, keys_ + kept, keys_ + run, end - run);
+            relocate_(mapped_allocator_, values_ + kept, values_ + run, end - run);
+            kept += end - run;
+        };
+
+        try {
+            for (size_type i = 0; i < size_; ) {
+                run = i;
+                while ((i < size_) && !remove(i)) {
+                    ++i;
+                }
+                keep(i);
+                run = i;
+
+                if (i < size_) {
+                    std::allocator_traits<key_allocator_type>::destroy(key_allocator_, keys_ + i);
+                    std::allocator_traits<mapped_allocator_type>::destroy(mapped_allocator_, values_ + i);
+                    run = ++i;
+                }
+            }
+        }
+        catch (...) {
+            keep(size_);
+            size_ = kept;
+            throw;
+        }
+
+        return std::exchange(size_, kept) - kept;
+    }
+
+template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    template<class F>
+    void soa_vectormap<key_, value_, delta_, growth_>::for_each_pos_(const key_type& key, F&& f) const {
+        if constexpr (simd::Scannable<key_type>) {
+            simd::for_each_match(keys_, size_, key, f);
+        }
+        else {
+            for (size_type i = 0; i < size_; ++i) {
+                if ((keys_[i] == key) && !f(i)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+#endif
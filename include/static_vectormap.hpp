@@ -0,0 +1,276 @@
+#ifndef __STATICVECTORMAP_H__
+#define __STATICVECTORMAP_H__
+
+#include "vectormap.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace com {
+    /**
+     * @brief Hash usable in constant expressions: integral and enumeration keys are mixed, strings are hashed with FNV-1a.\n
+     *        Every type convertible to std::string_view hashes as its characters.
+     */
+    struct static_hash {
+        template<class T>
+        requires std::is_integral_v<T> || std::is_enum_v<T>
+        constexpr size_t operator()(T key) const {
+            uint64_t x = static_cast<uint64_t>(key);
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            return static_cast<size_t>(x ^ (x >> 31));
+        }
+
+        constexpr size_t operator()(std::string_view key) const {
+            uint64_t h = 0xcbf29ce484222325ull;
+            for (char c : key) {
+                h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+    /**
+     * @brief Read-only vectormap of up to capacity_ elements stored inline, built and queried in constant expressions.\n
+     *        Declared constexpr, a table is computed by the compiler and placed in read-only data,
+     *        without any static initialization at startup:
+     *        @code
+     *        constexpr com::static_vectormap<int, std::string_view, 3> names({{200, "OK"}, {404, "Not Found"}, {500, "Error"}});
+     *        static_assert(names.find(404)->second == "Not Found");
+     *        @endcode
+     *
+     *        The elements keep their order and the keys may repeat, as in vectormap. When hash_ accepts the key,
+     *        the constructor also builds an open addressing table of the distinct keys, at most half full, chaining
+     *        the positions of every key: the lookups cost O(1) plus the matches visited instead of a scan.
+     *        The table takes four words per element.
+     *
+     * @tparam key_      Type of the key.
+     * @tparam value_    Type of the value.
+     * @tparam capacity_ Maximum number of elements.
+     * @tparam hash_     Hash of the keys usable in constant expressions (see static_hash).
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t capacity_, class hash_ = static_hash>
+    class static_vectormap
+    {
+        public:
+            /** @cond */
+            using key_type = key_;
+            using mapped_type = value_;
+            using value_type = std::pair<key_type, mapped_type>;
+            using const_reference = const value_type&;
+            using const_pointer = const value_type*;
+            using const_iterator = const_pointer;
+            using iterator = const_iterator;
+            using size_type = size_t;
+
+            static constexpr size_type npos = std::numeric_limits<size_type>::max();
+            static constexpr bool positional_overloads = !(std::is_convertible_v<key_type, size_type> && std::is_convertible_v<size_type, key_type>);
+            static constexpr bool hashed = std::is_invocable_r_v<size_t, const hash_&, const key_type&>;
+            /** @endcond */
+
+            /** @name Constructors */
+            /** @{ */
+            constexpr static_vectormap() { slots_.fill(npos); }
+            /**
+             * @brief Table holding the given elements, in the same order.
+             *
+             * @param elems  Elements of the table, at most capacity_.
+             */
+            template<size_t n_>
+            requires (n_ <= capacity_)
+            constexpr static_vectormap(const value_type (&elems)[n_]) : static_vectormap() {
+                for (const value_type& elem : elems) {
+                    data_[size_] = elem;
+                    link_(size_++);
+                }
+            }
+            /** @} */
+
+            /** @name Element access */
+            /** @{ */
+            constexpr const_iterator get(const size_type pos) const requires positional_overloads { return get_at(pos); }
+            constexpr const_iterator get_at(const size_type pos) const { return pos < size_ ? data_.data() + pos : end(); }
+            constexpr const key_type& get_key_at(const size_type pos) const { return pos < size_ ? data_[pos].first : void_element_.first; }
+            constexpr const mapped_type& get_value_at(const size_type pos) const { return pos < size_ ? data_[pos].second : void_element_.second; }
+            constexpr const key_type& get_key(const size_type pos) const { return get_key_at(pos); }
+            constexpr const mapped_type& get_value(const size_type pos) const requires positional_overloads { return get_value_at(pos); }
+            constexpr const_reference operator[](const size_type pos) const { return data_[pos]; }
+            constexpr std::vector<mapped_type> get_value(const key_type& key, size_type ordinal = 1, size_type number = 1) const { return get_value<key_type>(key, ordinal, number); }
+            template<KeyComparableWith<key_> K>
+            constexpr std::vector<mapped_type> get_value(const K& key, size_type ordinal = 1, size_type number = 1) const;
+            constexpr std::vector<mapped_type> get_all_values(const key_type& key) const { return get_value<key_type>(key, 1, npos); }
+            template<KeyComparableWith<key_> K>
+            constexpr std::vector<mapped_type> get_all_values(const K& key) const { return get_value(key, 1, npos); }
+            constexpr std::vector<size_type> get_pos(const key_type& key, size_type ordinal = 1, size_type number = 1) const { return get_pos<key_type>(key, ordinal, number); }
+            template<KeyComparableWith<key_> K>
+            constexpr std::vector<size_type> get_pos(const K& key, size_type ordinal = 1, size_type number = 1) const;
+            constexpr std::vector<size_type> get_all_pos(const key_type& key) const { return get_pos<key_type>(key, 1, npos); }
+            template<KeyComparableWith<key_> K>
+            constexpr std::vector<size_type> get_all_pos(const K& key) const { return get_pos(key, 1, npos); }
+            /**
+             * @brief Finds the first element with a given key.
+             *
+             * @param key              Key to look for.
+             * @return const_iterator  Iterator pointing to the element, end() if there is none.
+             */
+            constexpr const_iterator find(const key_type& key) const { return find_nth<key_type>(key, 1); }
+            template<KeyComparableWith<key_> K>
+            constexpr const_iterator find(const K& key) const { return find_nth(key, 1); }
+            constexpr const_iterator find_nth(const key_type& key, size_type ordinal) const { return find_nth<key_type>(key, ordinal); }
+            template<KeyComparableWith<key_> K>
+            constexpr const_iterator find_nth(const K& key, size_type ordinal) const;
+            constexpr size_type count(const key_type& key) const { return count<key_type>(key); }
+            template<KeyComparableWith<key_> K>
+            constexpr size_type count(const K& key) const;
+            constexpr bool contains(const key_type& key) const { return find(key) != end(); }
+            template<KeyComparableWith<key_> K>
+            constexpr bool contains(const K& key) const { return find(key) != end(); }
+            constexpr const_pointer data() const { return data_.data(); }
+            /** @} */
+
+            /** @name  Memory manipulation */
+            /** @{ */
+            constexpr size_type size() const { return size_; }
+            constexpr bool is_empty() const { return size_ == 0; }
+            static constexpr size_type capacity() { return capacity_; }
+            /** @} */
+
+            /** @name  Iterators */
+            /** @{ */
+            constexpr const_iterator begin() const { return data_.data(); }
+            constexpr const_iterator end() const { return data_.data() + size_; }
+            constexpr const_iterator cbegin() const { return begin(); }
+            constexpr const_iterator cend() const { return end(); }
+            /** @} */
+
+        private:
+            static constexpr size_type slot_count_ = hashed ? std::bit_ceil(2 * capacity_ + 1) : 1;
+            static constexpr value_type void_element_{};
+
+            std::array<value_type, capacity_> data_{};
+            size_type size_ = 0;
+            std::array<size_type, slot_count_> slots_{};                     // First position of every distinct key, npos if free.
+            std::array<size_type, hashed ? capacity_ : 0> next_{};           // Next position with the same key, npos after the last one.
+            std::array<size_type, hashed ? capacity_ : 0> last_{};           // Last position with the key of a first position.
+
+            // Adds the element at pos to the chain of its key.
+            constexpr void link_(size_type pos) {
+                if constexpr (hashed) {
+                    next_[pos] = npos;
+                    size_type* slot = slot_(data_[pos].first);
+                    if (*slot == npos) {
+                        *slot = pos;
+                        last_[pos] = pos;
+                    }
+                    else {
+                        next_[last_[*slot]] = pos;
+                        last_[*slot] = pos;
+                    }
+                }
+            }
+
+            // Slot holding the first position of key, or the free slot where it would go.
+            template<class K>
+            constexpr size_type* slot_(const K& key) {
+                return const_cast<size_type*>(std::as_const(*this).slot_(key));
+            }
+
+            template<class K>
+            constexpr const size_type* slot_(const K& key) const {
+                size_type i = static_cast<size_type>(hash_()(key)) & (slot_count_ - 1);
+                while ((slots_[i] != npos) && !(data_[slots_[i]].first == key)) {
+                    i = (i + 1) & (slot_count_ - 1);
+                }
+                return &slots_[i];
+            }
+
+            /**
+             * @brief Calls f(pos) for every position holding key, in ascending order, until f returns false.
+             */
+            template<class K, class F>
+            constexpr void for_each_pos_(const K& key, F&& f) const {
+                if constexpr (hashed && std::is_invocable_r_v<size_t, const hash_&, const K&>) {
+                    for (size_type i = *slot_(key); i != npos; i = next_[i]) {
+                        if (!f(i)) {
+                            return;
+                        }
+                    }
+                }
+                else {
+                    for (size_type i = 0; i < size_; ++i) {
+                        if ((data_[i].first == key) && !f(i)) {
+                            return;
+                        }
+                    }
+                }
+            }
+    };
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t capacity_, class hash_>
+    template<KeyComparableWith<key_> K>
+    constexpr std::vector<typename static_vectormap<key_, value_, capacity_, hash_>::mapped_type> static_vectormap<key_, value_, capacity_, hash_>::get_value(const K& key, size_type ordinal, size_type number) const {
+        std::vector<mapped_type> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order++ >= ordinal) {
+                out.push_back(data_[i].second);
+            }
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t capacity_, class hash_>
+    template<KeyComparableWith<key_> K>
+    constexpr std::vector<typename static_vectormap<key_, value_, capacity_, hash_>::size_type> static_vectormap<key_, value_, capacity_, hash_>::get_pos(const K& key, size_type ordinal, size_type number) const {
+        std::vector<size_type> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order++ >= ordinal) {
+                out.push_back(i);
+            }
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t capacity_, class hash_>
+    template<KeyComparableWith<key_> K>
+    constexpr typename static_vectormap<key_, value_, capacity_, hash_>::const_iterator static_vectormap<key_, value_, capacity_, hash_>::find_nth(const K& key, size_type ordinal) const {
+        const_iterator out = end();
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order++ >= ordinal) {
+                out = data_.data() + i;
+                return false;
+            }
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t capacity_, class hash_>
+    template<KeyComparableWith<key_> K>
+    constexpr typename static_vectormap<key_, value_, capacity_, hash_>::size_type static_vectormap<key_, value_, capacity_, hash_>::count(const K& key) const {
+        size_type out = 0;
+        for_each_pos_(key, [&](size_type) {
+            ++out;
+            return true;
+        });
+
+        return out;
+    }
+}
+#endif
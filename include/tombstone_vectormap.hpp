@@ -0,0 +1,514 @@
+#ifndef __TOMBSTONEVECTORMAP_H__
+#define __TOMBSTONEVECTORMAP_H__
+
+#include "vectormap.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace com {
+    /**
+     * @brief vectormap whose erasures only mark the element as dead (a tombstone) instead of shifting the ones behind it.\n
+     *        Lookups and iteration skip the dead elements, which are removed in a single pass by compact(),
+     *        automatically once they exceed a ratio of the stored elements (see compaction_ratio).
+     *        Erasing from the front, as a FIFO does, costs O(log n) amortized instead of O(n).
+     *
+     *        Positions are logical: get_at(pos) is the pos-th live element. They are mapped to the storage
+     *        with a bitmap of the live elements and a Fenwick tree of its counts per word, in O(log n).
+     *        A dead element keeps its key and value, and the resources they own, until the next compaction.
+     *
+     * @tparam key_    Type of the key.
+     * @tparam value_  Type of the value.
+     * @tparam delta_  Number of new elements to allocate every time the container growths.
+     * @tparam growth_ Policy that computes the new capacity when the container growths (see delta_growth).
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100, class growth_ = delta_growth>
+    class tombstone_vectormap
+    {
+        public:
+            template<bool const_> class Iterator;
+
+            /** @cond */
+            using storage_type = vectormap<key_, value_, delta_, no_index, growth_>;
+            using key_type = key_;
+            using mapped_type = value_;
+            using value_type = typename storage_type::value_type;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+            using size_type = size_t;
+            using iterator_pos = std::pair<iterator, size_type>;
+
+            static constexpr size_type npos = std::numeric_limits<size_type>::max();
+            static constexpr bool positional_overloads = storage_type::positional_overloads;
+            /** @endcond */
+
+            /**
+             * @brief Bidirectional iterator over the live elements.
+             */
+            template<bool const_>
+            class Iterator {
+                public:
+                    using owner_pointer = std::conditional_t<const_, const tombstone_vectormap*, tombstone_vectormap*>;
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = typename tombstone_vectormap::value_type;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<const_, const value_type*, value_type*>;
+                    using reference = std::conditional_t<const_, const value_type&, value_type&>;
+
+                    Iterator(owner_pointer owner = nullptr, size_type slot = 0) : owner_(owner), slot_(slot) {}
+                    operator Iterator<true>() const requires (!const_) { return Iterator<true>(owner_, slot_); }
+
+                    reference operator*() const { return owner_->storage_[slot_]; }
+                    pointer operator->() const { return &owner_->storage_[slot_]; }
+                    Iterator& operator++() { slot_ = owner_->next_live_(slot_ + 1); return *this; }
+                    Iterator operator++(int) { Iterator tmp = *this; ++*this; return tmp; }
+                    Iterator& operator--() { slot_ = owner_->prev_live_(slot_); return *this; }
+                    Iterator operator--(int) { Iterator tmp = *this; --*this; return tmp; }
+                    bool operator==(const Iterator& other) const { return slot_ == other.slot_; }
+
+                    /**
+                     * @brief Index of the element in the storage, dead elements included.
+                     */
+                    size_type slot() const { return slot_; }
+
+                private:
+                    owner_pointer owner_;
+                    size_type slot_;
+            };
+
+            /** @name Constructors */
+            /** @{ */
+            tombstone_vectormap() = default;
+            tombstone_vectormap(const std::initializer_list<value_type>& il);
+            /** @} */
+
+            /** @name Element insertion */
+            /** @{ */
+            iterator push_back(const value_type& val) { return emplace_back(val); }
+            iterator push_back(const key_type& key, const mapped_type& val) { return emplace_back(key, val); }
+            template<class... Args>
+            iterator emplace_back(Args&&... args);
+            /**
+             * @brief Inserts an element at a given logical position.\n
+             *        Inserting anywhere but at the end compacts the vectormap first.
+             *
+             * @param val        Element to insert.
+             * @param pos        Logical position of the new element.
+             * @return iterator  Iterator pointing to the added element, end() if pos is out of range.
+             */
+            iterator insert(const value_type& val, const size_type pos);
+            /** @} */
+
+            /** @name Element access */
+            /** @{ */
+            iterator get(const size_type pos) requires positional_overloads { return get_at(pos); }
+            const key_type& get_key(const size_type pos) const requires positional_overloads { return get_key_at(pos); }
+            mapped_type& get_value(const size_type pos) requires positional_overloads { return get_value_at(pos); }
+            const mapped_type& get_value(const size_type pos) const requires positional_overloads { return get_value_at(pos); }
+            std::vector<mapped_type> get_value(const key_type& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<mapped_type> get_all_values(const key_type& key) const;
+            std::vector<size_type> get_all_pos(const key_type& key) const;
+            iterator get_at(const size_type pos) { return pos < size() ? iterator(this, select_(pos)) : end(); }
+            const_iterator get_at(const size_type pos) const { return pos < size() ? const_iterator(this, select_(pos)) : end(); }
+            const key_type& get_key_at(const size_type pos) const { return storage_.get_key_at(pos < size() ? select_(pos) : npos); }
+            mapped_type& get_value_at(const size_type pos) { return storage_.get_value_at(pos < size() ? select_(pos) : npos); }
+            const mapped_type& get_value_at(const size_type pos) const { return storage_.get_value_at(pos < size() ? select_(pos) : npos); }
+            reference operator[](const size_type pos) { return storage_[select_(pos)]; }
+            const_reference operator[](const size_type pos) const { return storage_[select_(pos)]; }
+            iterator find(const key_type& key) { return find_nth(key, 1); }
+            const_iterator find(const key_type& key) const { return find_nth(key, 1); }
+            iterator find_nth(const key_type& key, size_type ordinal) { return iterator(this, find_slot_(key, ordinal)); }
+            const_iterator find_nth(const key_type& key, size_type ordinal) const { return const_iterator(this, find_slot_(key, ordinal)); }
+            size_type count(const key_type& key) const;
+            bool contains(const key_type& key) const { return find_slot_(key, 1) != storage_.size(); }
+            /** @} */
+
+            /** @name  Element modification */
+            /** @{ */
+            void set_value(const mapped_type& new_mapped_value, const key_type& key, size_type ordinal = 1);
+            void set_value_at(const mapped_type& new_mapped_value, const size_type pos) { if (pos < size()) storage_.set_value_at(new_mapped_value, select_(pos)); }
+            void set_key_at(const key_type& new_key, const size_type pos) { if (pos < size()) storage_.set_key_at(new_key, select_(pos)); }
+            /** @} */
+
+            /** @name  Element management */
+            /** @{ */
+            void clear();
+            void erase(const size_type pos) requires positional_overloads { erase_at(pos); }
+            /**
+             * @brief Marks the element at a given logical position as dead.\n
+             *        The positions of the elements behind it decrease by one; nothing is moved until the next compaction.
+             *
+             * @param pos  Logical position of the element.
+             */
+            void erase_at(const size_type pos);
+            void erase(const key_type& key);
+            size_type erase_all(const key_type& key);
+            /**
+             * @brief Removes the dead elements, shifting each live one at most once.
+             *
+             * @return size_type  Number of removed dead elements.
+             */
+            size_type compact();
+            /**
+             * @brief Number of dead elements waiting for the next compaction.
+             */
+            size_type tombstones() const { return dead_; }
+            /**
+             * @brief Sets the ratio of dead to stored elements above which an erasure compacts the vectormap.\n
+             *        1 or more disables the automatic compaction. The default ratio is 0.5.
+             */
+            void compaction_ratio(double ratio) { ratio_ = ratio; }
+            double compaction_ratio() const { return ratio_; }
+            /** @} */
+
+            /** @name  Memory manipulation */
+            /** @{ */
+            size_type size() const { return storage_.size() - dead_; }
+            size_type capacity() const { return storage_.capacity(); }
+            bool is_empty() const { return size() == 0; }
+            bool reserve(size_type min_capacity) { return storage_.reserve(min_capacity); }
+            /**
+             * @brief Underlying vectormap, dead elements included.
+             */
+            const storage_type& storage() const { return storage_; }
+            /** @} */
+
+            /** @name  Iterators */
+            /** @{ */
+            iterator begin() { return iterator(this, next_live_(0)); }
+            iterator end() { return iterator(this, storage_.size()); }
+            const_iterator begin() const { return const_iterator(this, next_live_(0)); }
+            const_iterator end() const { return const_iterator(this, storage_.size()); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+            /** @} */
+
+        private:
+            static constexpr size_type word_bits_ = 64;
+
+            storage_type storage_;
+            std::vector<uint64_t> live_;        // One bit per stored element.
+            std::vector<size_type> tree_{0};    // Fenwick tree of the live bits per word, 1-based.
+            size_type dead_ = 0;
+            double ratio_ = 0.5;
+
+            void add_(size_type word, std::ptrdiff_t delta);
+            size_type prefix_(size_type word) const;
+            size_type rank_(size_type slot) const;
+            size_type select_(size_type pos) const;
+            size_type next_live_(size_type slot) const;
+            size_type prev_live_(size_type slot) const;
+            bool is_live_(size_type slot) const { return (live_[slot / word_bits_] >> (slot % word_bits_)) & 1; }
+            void append_live_();
+            void kill_(size_type slot);
+            void rebuild_();
+            void maybe_compact_();
+            size_type find_slot_(const key_type& key, size_type ordinal) const;
+
+            template<class F>
+            void for_each_live_(const key_type& key, F&& f) const;
+    };
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    tombstone_vectormap<key_, value_, delta_, growth_>::tombstone_vectormap(const std::initializer_list<value_type>& il) : storage_(il) {
+        rebuild_();
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    template<class... Args>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::iterator tombstone_vectormap<key_, value_, delta_, growth_>::emplace_back(Args&&... args) {
+        const size_type slot = storage_.size();
+        storage_.emplace_back(std::forward<Args>(args)...);
+
+        append_live_();
+        return iterator(this, slot);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::iterator tombstone_vectormap<key_, value_, delta_, growth_>::insert(const value_type& val, const size_type pos) {
+        if (pos == size()) {
+            return emplace_back(val);
+        }
+        if (pos > size()) {
+            return end();
+        }
+
+        compact();
+        storage_.insert(val, pos);
+        rebuild_();
+        return iterator(this, pos);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename tombstone_vectormap<key_, value_, delta_, growth_>::mapped_type> tombstone_vectormap<key_, value_, delta_, growth_>::get_value(const key_type& key, size_type ordinal, size_type number) const {
+        std::vector<mapped_type> out;
+        size_type order = 1;
+
+        for_each_live_(key, [&](size_type slot) {
+            if (order >= ordinal) {
+                out.push_back(storage_[slot].second);
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename tombstone_vectormap<key_, value_, delta_, growth_>::mapped_type> tombstone_vectormap<key_, value_, delta_, growth_>::get_all_values(const key_type& key) const {
+        std::vector<mapped_type> out;
+        for_each_live_(key, [&](size_type slot) {
+            out.push_back(storage_[slot].second);
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    std::vector<typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type> tombstone_vectormap<key_, value_, delta_, growth_>::get_all_pos(const key_type& key) const {
+        std::vector<size_type> out;
+        for_each_live_(key, [&](size_type slot) {
+            out.push_back(rank_(slot));
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::count(const key_type& key) const {
+        size_type out = 0;
+        for_each_live_(key, [&](size_type) {
+            ++out;
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::set_value(const mapped_type& new_mapped_value, const key_type& key, size_type ordinal) {
+        size_type slot = find_slot_(key, ordinal);
+        if (slot != storage_.size()) {
+            storage_.set_value_at(new_mapped_value, slot);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::clear() {
+        storage_.clear();
+        rebuild_();
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::erase_at(const size_type pos) {
+        if (pos < size()) {
+            kill_(select_(pos));
+            maybe_compact_();
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::erase(const key_type& key) {
+        size_type slot = find_slot_(key, 1);
+        if (slot != storage_.size()) {
+            kill_(slot);
+            maybe_compact_();
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::erase_all(const key_type& key) {
+        size_type out = 0;
+        std::vector<size_type> slots;
+        for_each_live_(key, [&](size_type slot) {
+            slots.push_back(slot);
+            return true;
+        });
+        for (size_type slot : slots) {
+            kill_(slot);
+            ++out;
+        }
+
+        maybe_compact_();
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::compact() {
+        if (dead_ == 0) {
+            return 0;
+        }
+
+        std::vector<size_type> slots;
+        slots.reserve(dead_);
+        for (size_type slot = 0; slot < storage_.size(); ++slot) {
+            if (!is_live_(slot)) {
+                slots.push_back(slot);
+            }
+        }
+
+        size_type out = storage_.erase_positions(slots);
+        rebuild_();
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::add_(size_type word, std::ptrdiff_t delta) {
+        for (size_type i = word + 1; i < tree_.size(); i += i & (~i + 1)) {
+            tree_[i] += delta;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::prefix_(size_type word) const {
+        // Live elements in the words before word.
+        size_type out = 0;
+        for (size_type i = word; i > 0; i -= i & (~i + 1)) {
+            out += tree_[i];
+        }
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::rank_(size_type slot) const {
+        const size_type word = slot / word_bits_;
+        const uint64_t below = (uint64_t(1) << (slot % word_bits_)) - 1;
+        return prefix_(word) + static_cast<size_type>(std::popcount(live_[word] & below));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::select_(size_type pos) const {
+        if (dead_ == 0) {
+            return pos;
+        }
+
+        // Descend the Fenwick tree to the word holding the pos-th live element, then find its bit.
+        size_type word = 0;
+        for (size_type step = std::bit_floor(tree_.size() - 1); step > 0; step >>= 1) {
+            if ((word + step < tree_.size()) && (tree_[word + step] <= pos)) {
+                word += step;
+                pos -= tree_[word];
+            }
+        }
+
+        uint64_t bits = live_[word];
+        for (; pos > 0; --pos) {
+            bits &= bits - 1;
+        }
+        return word * word_bits_ + static_cast<size_type>(std::countr_zero(bits));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::next_live_(size_type slot) const {
+        size_type word = slot / word_bits_;
+        if (word >= live_.size()) {
+            return storage_.size();
+        }
+
+        uint64_t bits = (slot % word_bits_) == 0 ? live_[word] : live_[word] & (~uint64_t(0) << (slot % word_bits_));
+        while (bits == 0) {
+            if (++word == live_.size()) {
+                return storage_.size();
+            }
+            bits = live_[word];
+        }
+        return word * word_bits_ + static_cast<size_type>(std::countr_zero(bits));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::prev_live_(size_type slot) const {
+        // Last live element before slot; there is always one when decrementing a valid iterator.
+        size_type word = (slot - 1) / word_bits_;
+        const size_type bit = (slot - 1) % word_bits_;
+        uint64_t bits = bit == word_bits_ - 1 ? live_[word] : live_[word] & ((uint64_t(2) << bit) - 1);
+        while (bits == 0) {
+            bits = live_[--word];
+        }
+        return word * word_bits_ + (word_bits_ - 1 - static_cast<size_type>(std::countl_zero(bits)));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::append_live_() {
+        const size_type slot = storage_.size() - 1;
+        const size_type word = slot / word_bits_;
+
+        if (word == live_.size()) {
+            // A new Fenwick node i covers the words (i - lowbit(i), i].
+            const size_type i = word + 1;
+            live_.push_back(0);
+            tree_.push_back(prefix_(word) - prefix_(i - (i & (~i + 1))));
+        }
+
+        live_[word] |= uint64_t(1) << (slot % word_bits_);
+        add_(word, 1);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::kill_(size_type slot) {
+        live_[slot / word_bits_] &= ~(uint64_t(1) << (slot % word_bits_));
+        add_(slot / word_bits_, -1);
+        ++dead_;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::rebuild_() {
+        // Every stored element is live.
+        const size_type n = storage_.size();
+        const size_type words = (n + word_bits_ - 1) / word_bits_;
+
+        live_.assign(words, ~uint64_t(0));
+        if (n % word_bits_ != 0) {
+            live_.back() = (uint64_t(1) << (n % word_bits_)) - 1;
+        }
+
+        tree_.assign(words + 1, 0);
+        for (size_type i = 1; i <= words; ++i) {
+            tree_[i] += static_cast<size_type>(std::popcount(live_[i - 1]));
+            const size_type parent = i + (i & (~i + 1));
+            if (parent <= words) {
+                tree_[parent] += tree_[i];
+            }
+        }
+        dead_ = 0;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::maybe_compact_() {
+        if (static_cast<double>(dead_) > ratio_ * static_cast<double>(storage_.size())) {
+            compact();
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    typename tombstone_vectormap<key_, value_, delta_, growth_>::size_type tombstone_vectormap<key_, value_, delta_, growth_>::find_slot_(const key_type& key, size_type ordinal) const {
+        size_type out = storage_.size();
+        size_type order = 1;
+
+        for_each_live_(key, [&](size_type slot) {
+            if (order++ >= ordinal) {
+                out = slot;
+                return false;
+            }
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class growth_>
+    template<class F>
+    void tombstone_vectormap<key_, value_, delta_, growth_>::for_each_live_(const key_type& key, F&& f) const {
+        storage_.for_each_pos(key, 0, storage_.size(), [&](size_type slot) {
+            return !is_live_(slot) || f(slot);
+        });
+    }
+}
+#endif
@@ -5,11 +5,20 @@
 #include <initializer_list>
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <vector>
 #include <type_traits>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 #include <concepts>
+#include <algorithm>
+#include <cstring>
+#include <ranges>
+#include <span>
+
+#include "vectormap_simd.hpp"
 
 /**
  * @brief General namespace
@@ -17,20 +26,336 @@
  */
 namespace com {
     template<class T>
-    concept Keyable = (requires(T a_, T b_) {a_ == b_;}) && (!std::is_integral<T>::value);
+    concept Keyable = requires(T a_, T b_) {a_ == b_;};
 
     template<class T>
     concept DefaultInitializableKeyable = Keyable<T> && std::default_initializable<T>;
 
+    /**
+     * @brief Types that the key lookups accept without converting them to Key: Key itself, or a non-arithmetic K
+     *        for which key == k is valid, e.g. std::string_view or const char* for std::string keys.\n
+     *        Arithmetic types are always converted to Key, so that they never compete with the positional overloads.
+     */
+    template<class K, class Key>
+    concept KeyComparableWith = std::same_as<K, Key> ||
+                                (!std::is_arithmetic_v<K> && requires(const Key& key, const K& k) { { key == k } -> std::convertible_to<bool>; });
+
+    /**
+     * @brief Ranges whose elements can construct a T, moving them when the range is an rvalue.
+     */
+    template<class R, class T>
+    concept InsertableRange = std::ranges::input_range<R> &&
+                              std::constructible_from<T, std::conditional_t<std::is_lvalue_reference_v<R>, std::ranges::range_reference_t<R>, std::ranges::range_rvalue_reference_t<R>>>;
+
+    /**
+     * @brief Tells whether moving an object to another address and forgetting the original
+     *        is equivalent to copying its bytes.\n
+     *        True for trivially copyable types. It can be specialized for other types
+     *        (e.g. types holding only pointers to heap memory that never points back to the object).
+     */
+    template<class T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+    /**
+     * @brief Tells whether objects of a type can be written as raw bytes and used again from those bytes,
+     *        as vectormap::serialize and vectormap_view do.\n
+     *        True for trivially copyable types. It can be specialized for other types whose bytes hold no addresses.
+     */
+    template<class T>
+    struct is_bitwise_serializable : std::is_trivially_copyable<T> {};
+
+    /**
+     * @brief Header of the blob written by vectormap::serialize.\n
+     *        It takes header_size bytes and is followed by the elements, laid out as in memory.
+     *        A blob can only be read on a machine with the same byte order and element layout.
+     */
+    struct serialized_header {
+        static constexpr uint32_t signature = 0x50414d56; // "VMAP"
+        static constexpr uint32_t current_version = 1;
+        static constexpr uint32_t native_order = 0x01020304;
+        static constexpr size_t header_size = 64;
+
+        uint32_t magic = signature;
+        uint32_t version = current_version;
+        uint32_t byte_order = native_order;
+        uint32_t element_size = 0;
+        uint32_t element_align = 0;
+        uint32_t key_size = 0;
+        uint64_t count = 0;
+
+        template<class value_type>
+        static serialized_header of(uint64_t count) {
+            serialized_header out;
+            out.element_size = sizeof(value_type);
+            out.element_align = alignof(value_type);
+            out.key_size = sizeof(typename value_type::first_type);
+            out.count = count;
+            return out;
+        }
+
+        /**
+         * @brief Reads the header of a blob holding elements of type value_type.
+         *
+         * @param blob   Serialized vectormap.
+         * @param out    Header read, when the blob is valid.
+         * @return bool  false if the blob is too short, misaligned, or was written for other elements.
+         */
+        template<class value_type>
+        static bool read(std::span<const std::byte> blob, serialized_header& out) {
+            if ((blob.size() < header_size) || (reinterpret_cast<uintptr_t>(blob.data()) % alignof(value_type) != 0)) {
+                return false;
+            }
+
+            std::memcpy(&out, blob.data(), sizeof(out));
+            serialized_header expected = of<value_type>(out.count);
+            return (out.magic == expected.magic) && (out.version == expected.version) && (out.byte_order == expected.byte_order) &&
+                   (out.element_size == expected.element_size) && (out.element_align == expected.element_align) && (out.key_size == expected.key_size) &&
+                   (out.count <= (blob.size() - header_size) / sizeof(value_type));
+        }
+    };
+
+    static_assert(sizeof(serialized_header) <= serialized_header::header_size);
+
+    /**
+     * @brief Index policy that keeps no secondary index.\n
+     *        Every key lookup is a linear scan of the container.
+     *
+     *        An index policy is notified by the vectormap of every change in the
+     *        positions of its elements through the following hooks:
+     *        - inserted(map, pos, count): after count elements have been inserted at pos.
+     *        - erasing(map, pos, count): before count elements at pos are removed.
+     *        - moved(map, from, to): after the element at from has been moved to to.
+     *        - swapped(map, a, b): after the elements at a and b have been swapped.
+     *        - key_changing(map, pos, new_key): before the key at pos is replaced.
+     *        - cleared(): after all the elements have been removed.
+     *        - compacted(map, removed): optional, after the elements at the old positions flagged in removed have been
+     *          erased at once (see erase_if), the others keeping their order. Without it, the index is cleared and
+     *          notified of the insertion of all the remaining elements.
+     *
+     *        When enabled is true, positions(key) must return a pointer to the
+     *        ascending list of positions holding key, or nullptr if there is none.
+     *        The lookups of a type comparable with the key (see KeyComparableWith) use the index
+     *        only if positions accepts that type too.
+     *
+     *        An index that is not enabled can still filter the key scans: when filters<K> is true,
+     *        for_each_candidate(key, first, last, f) must call f(pos), in ascending order, for every position
+     *        in [first, last) that may hold key, until f returns false, and return false if f stopped.
+     *        The vectormap compares the keys of the candidates.
+     *
+     *        An index whose ordered is true keeps the positions sorted by key (see sorted_index):
+     *        sorted() must return them, and lower_bound(map, key), upper_bound(map, key) and equal_range(map, key)
+     *        must search them like the standard algorithms. The key lookups walk equal_range.
+     *
+     *        An index whose stable is true identifies every element with a stable_handle (see stable_index):
+     *        handle(pos) must return the handle of the element at pos, and pos(handle) its current position,
+     *        or npos once the element has been erased.
+     */
+    struct no_index {
+        static constexpr bool enabled = false;
+
+        template<class map_> void inserted(const map_&, size_t, size_t) {}
+        template<class map_> void erasing(const map_&, size_t, size_t) {}
+        template<class map_> void moved(const map_&, size_t, size_t) {}
+        template<class map_> void swapped(const map_&, size_t, size_t) {}
+        template<class map_, class key_> void key_changing(const map_&, size_t, const key_&) {}
+        void cleared() {}
+    };
+
+    /**
+     * @brief Opaque identifier of an element of a vectormap with a stable index (see stable_index).\n
+     *        A default constructed handle identifies no element.
+     */
+    struct stable_handle {
+        size_t slot = std::numeric_limits<size_t>::max();
+        size_t generation = 0;
+
+        bool operator==(const stable_handle&) const = default;
+    };
+
+    /**
+     * @brief Growth policy that adds delta elements every time the container growths.\n
+     *        The new capacity is rounded up to the next multiple of delta.
+     */
+    struct delta_growth {
+        static constexpr size_t grow(size_t, size_t min_capacity, size_t delta) {
+            return ((min_capacity / delta) + 1) * delta;
+        }
+    };
+
+    /**
+     * @brief Growth policy that multiplies the capacity by num_ / den_ every time the container growths,
+     *        so that push_back runs in amortized constant time.\n
+     *        The first allocation holds at least delta elements.
+     *
+     * @tparam num_ Numerator of the growth factor.
+     * @tparam den_ Denominator of the growth factor.
+     */
+    template<size_t num_ = 2, size_t den_ = 1>
+    struct geometric_growth {
+        static_assert(num_ > den_, "The growth factor must be greater than 1");
+
+        static constexpr size_t grow(size_t capacity, size_t min_capacity, size_t delta) {
+            return std::max({min_capacity, (capacity / den_) * num_ + ((capacity % den_) * num_) / den_, delta});
+        }
+    };
+
+    /**
+     * @brief Growth policy that adds delta elements while the capacity is below threshold_,
+     *        and then multiplies it by num_ / den_.
+     *
+     * @tparam threshold_ Capacity from which the container growths geometrically.
+     * @tparam num_       Numerator of the growth factor.
+     * @tparam den_       Denominator of the growth factor.
+     */
+    template<size_t threshold_, size_t num_ = 2, size_t den_ = 1>
+    struct hybrid_growth {
+        static constexpr size_t grow(size_t capacity, size_t min_capacity, size_t delta) {
+            return capacity < threshold_ ? delta_growth::grow(capacity, min_capacity, delta)
+                                         : geometric_growth<num_, den_>::grow(capacity, min_capacity, delta);
+        }
+    };
+
+    /**
+     * @brief Growth policy adaptor that also keeps spare room before the first element.\n
+     *        Insertions and erasures in the first half of the vectormap shift the elements in front of
+     *        the modified position instead of the ones behind it, so push_front and erase(0) run in
+     *        amortized constant time. When the head room runs out, the elements are recentred in place
+     *        if at most half of the buffer is used, and reallocated with growth_ otherwise; in both cases
+     *        the free room is split evenly between both ends. data() stays contiguous.
+     *
+     * @tparam growth_ Policy that computes the new capacity of the buffer.
+     */
+    template<class growth_ = geometric_growth<2>>
+    struct front_gap {
+        static constexpr bool front_room = true;
+
+        static constexpr size_t grow(size_t capacity, size_t min_capacity, size_t delta) {
+            return growth_::grow(capacity, min_capacity, delta);
+        }
+    };
+
+    /**
+     * @brief Growth policy adaptor that also releases memory: after an erasure or a clear leaves fewer than
+     *        num_ / den_ of the capacity in use, the buffer is reallocated to the capacity growth_ gives to the
+     *        remaining elements, and released when none remains.\n
+     *        Without it, the capacity only goes down with an explicit shrink().
+     *
+     * @tparam num_    Numerator of the fraction of the capacity below which the buffer is shrunk.
+     * @tparam den_    Denominator of that fraction.
+     * @tparam growth_ Policy that computes the new capacity of the buffer.
+     */
+    template<size_t num_ = 1, size_t den_ = 4, class growth_ = geometric_growth<2>>
+    struct auto_shrink {
+        static_assert(2 * num_ <= den_, "The buffer must stay at most half full after shrinking, or it would shrink and grow back in turns");
+
+        static constexpr bool front_room = requires { requires growth_::front_room; };
+
+        static constexpr size_t grow(size_t capacity, size_t min_capacity, size_t delta) {
+            return growth_::grow(capacity, min_capacity, delta);
+        }
+
+        static constexpr size_t shrink(size_t capacity, size_t size, size_t delta) {
+            if (size * den_ >= capacity * num_) {
+                return capacity;
+            }
+            return size == 0 ? 0 : std::min(capacity, growth_::grow(size, size, delta));
+        }
+    };
+
+    /**
+     * @brief Counters of the work done by a vectormap (see counting_stats).
+     */
+    struct vectormap_stats {
+        size_t resizes = 0;         ///< Calls to resize, reserve and shrink.
+        size_t allocations = 0;     ///< Buffers obtained from the allocator.
+        size_t bytes_allocated = 0; ///< Total size of those buffers.
+        size_t relocations = 0;     ///< Elements relocated when making room, erasing, moving or reallocating.
+        size_t lookups = 0;         ///< Key lookups, by get, find, count, erase and friends.
+        size_t compared = 0;        ///< Elements compared (or index entries visited) by those lookups.
+        size_t peak_size = 0;       ///< Largest number of elements held at once.
+    };
+
+    /**
+     * @brief Statistics policy that counts nothing. Its hooks compile to nothing.
+     */
+    struct no_stats {
+        static constexpr bool enabled = false;
+
+        void resizing() {}
+        void allocated(size_t) {}
+        void relocated(size_t) {}
+        void looked_up(size_t) {}
+        void grown(size_t) {}
+    };
+
+    /**
+     * @brief Statistics policy that fills a vectormap_stats, exposed by vectormap::stats().\n
+     *        Lookups update it too, so const vectormaps using it must not be shared between threads.
+     */
+    struct counting_stats : vectormap_stats {
+        static constexpr bool enabled = true;
+
+        void resizing() { ++resizes; }
+        void allocated(size_t bytes) { ++allocations; bytes_allocated += bytes; }
+        void relocated(size_t n) { relocations += n; }
+        void looked_up(size_t n) { ++lookups; compared += n; }
+        void grown(size_t size) { peak_size = std::max(peak_size, size); }
+    };
+
+    /** @cond */
+    // Writable stand-in for a value out of range: private to each thread and reset on every call,
+    // so that nothing written through it is ever read back.
+    template<class T>
+    T& discarded_value() {
+        static thread_local T value{};
+        value = T();
+        return value;
+    }
+
+    // Uninitialized room for n_ objects of type T inside another object.
+    template<class T, size_t n_>
+    struct inline_buffer {
+        alignas(T) std::byte bytes[n_ * sizeof(T)];
+        T* data() { return reinterpret_cast<T*>(bytes); }
+        bool holds(const T* p) const { return static_cast<const void*>(p) == static_cast<const void*>(bytes); }
+    };
+
+    template<class T>
+    struct inline_buffer<T, 0> {
+        T* data() { return nullptr; }
+        bool holds(const T*) const { return false; }
+    };
+
+    // Number of free elements before the first one, only stored by the front_gap policies.
+    template<bool enabled_>
+    struct front_room {
+        size_t n = 0;
+        size_t get() const { return n; }
+        void set(size_t room) { n = room; }
+    };
+
+    template<>
+    struct front_room<false> {
+        size_t get() const { return 0; }
+        void set(size_t) {}
+    };
+    /** @endcond */
+
     /**
      * @brief Container that stores pairs of key / value respecting the insert order.
      *        It can be described as a vector with map functionality.
-     * 
-     * @tparam key_   Type of the key.
-     * @tparam value_ Type of the value.
-     * @tparam delta_ Number of new elements to allocate every time the container growths.
+     *
+     * @tparam key_      Type of the key.
+     * @tparam value_    Type of the value.
+     * @tparam delta_    Number of new elements to allocate every time the container growths.
+     * @tparam indexing_ Secondary index policy used to speed up the key lookups (see no_index).
+     * @tparam growth_   Policy that computes the new capacity when the container growths (see delta_growth).
+     * @tparam alloc_    Allocator of the elements. It follows the standard propagation rules.
+     * @tparam inline_     Number of elements stored inside the object before using the allocator (see small_vectormap).
+     * @tparam statistics_ Policy that counts the work done by the container (see no_stats and counting_stats).
      */
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100>
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100, class indexing_ = no_index, class growth_ = delta_growth,
+             class alloc_ = std::allocator<std::pair<const key_, value_>>, size_t inline_ = 0, class statistics_ = no_stats>
     class vectormap
     {
         public:
@@ -41,7 +366,7 @@ namespace com {
             using key_type = key_;
             using mapped_type = value_;
             using value_type = std::pair<const key_type, mapped_type>;
-            using allocator_type = std::allocator<value_type>;
+            using allocator_type = alloc_;
             using allocator_traits = std::allocator_traits<allocator_type>;
             using reference = value_type&;
             using const_reference = const value_type&;
@@ -53,15 +378,42 @@ namespace com {
             using const_reverse_iterator = std::reverse_iterator<const_iterator>;
             using size_type = size_t;
             using iterator_pos = std::pair<iterator, size_type>;
+            using index_type = indexing_;
+            using growth_type = growth_;
+            using statistics_type = statistics_;
             
             static constexpr size_type npos = std::numeric_limits<size_type>::max();
+            /**
+             * @brief False when the key and the position types convert to each other (e.g. integral keys).\n
+             *        Then the positional overloads of get, get_value, set, set_value, set_key and erase are
+             *        removed so that those names always take a key; use the *_at accessors instead.
+             */
+            static constexpr bool positional_overloads = !(std::is_convertible_v<key_type, size_type> && std::is_convertible_v<size_type, key_type>);
+            static constexpr bool ordered = requires { requires index_type::ordered; };
+            /**
+             * @brief Tells whether the index gives the elements stable handles (see stable_index and resolve).
+             */
+            static constexpr bool stable = requires { requires index_type::stable; };
 
+            static_assert(std::is_same_v<typename allocator_traits::value_type, value_type>, "The allocator must allocate value_type");
+
+            static constexpr size_type inline_capacity = inline_;
+            /**
+             * @brief Tells whether the growth policy keeps room before the first element (see front_gap).
+             */
+            static constexpr bool front_gap_enabled = requires { requires growth_type::front_room; };
+            static_assert(!(front_gap_enabled && (inline_ > 0)), "The front gap policies cannot be combined with inline storage");
             /** @endcond */
 
+            /**
+             * @brief Iterator over the contiguous elements: a thin wrapper around a pointer, modelling std::contiguous_iterator.
+             */
             class Iterator {
                 public:
-                    using iterator_category = std::bidirectional_iterator_tag;
+                    using iterator_category = std::random_access_iterator_tag;
+                    using iterator_concept = std::contiguous_iterator_tag;
                     using value_type = typename vectormap::value_type;
+                    using element_type = value_type;
                     using difference_type = std::ptrdiff_t;
                     using pointer = value_type*;
                     using reference = value_type&;
@@ -69,14 +421,19 @@ namespace com {
                     Iterator(pointer ptr = nullptr) : ptr_(ptr) {}
                     reference operator*() const { return *ptr_; }
                     pointer operator->() const { return ptr_; }
-                    iterator operator+(int other) { return iterator(ptr_ + other); }
-                    iterator operator-(int other) { return iterator(ptr_ - other); }
+                    reference operator[](difference_type n) const { return ptr_[n]; }
                     iterator& operator++() { ++ptr_; return *this; }
                     iterator operator++(int) { iterator tmp = *this; ++ptr_; return tmp; }
                     iterator& operator--() { --ptr_; return *this; }
                     iterator operator--(int) { iterator tmp = *this; --ptr_; return tmp; }
+                    iterator& operator+=(difference_type n) { ptr_ += n; return *this; }
+                    iterator& operator-=(difference_type n) { ptr_ -= n; return *this; }
+                    friend iterator operator+(const iterator& it, difference_type n) { return iterator(it.ptr_ + n); }
+                    friend iterator operator+(difference_type n, const iterator& it) { return iterator(it.ptr_ + n); }
+                    friend iterator operator-(const iterator& it, difference_type n) { return iterator(it.ptr_ - n); }
+                    friend difference_type operator-(const iterator& a, const iterator& b) { return a.ptr_ - b.ptr_; }
                     bool operator==(const iterator& other) const { return ptr_ == other.ptr_; }
-                    bool operator!=(const iterator& other) const { return ptr_ != other.ptr_; }
+                    auto operator<=>(const iterator& other) const { return ptr_ <=> other.ptr_; }
 
                     operator ConstIterator() const { return static_cast<const_pointer>(ptr_); }
 
@@ -87,8 +444,10 @@ namespace com {
 
             class ConstIterator {
                 public:
-                    using iterator_category = std::bidirectional_iterator_tag;
-                    using value_type = const vectormap::value_type;
+                    using iterator_category = std::random_access_iterator_tag;
+                    using iterator_concept = std::contiguous_iterator_tag;
+                    using value_type = typename vectormap::value_type;
+                    using element_type = const value_type;
                     using difference_type = std::ptrdiff_t;
                     using pointer = const value_type*;
                     using reference = const value_type&;
@@ -96,14 +455,19 @@ namespace com {
                     ConstIterator(pointer ptr = nullptr) : ptr_(ptr) {}
                     reference operator*() const { return *ptr_; }
                     pointer operator->() const { return ptr_; }
-                    ConstIterator operator+(int other) { return const_iterator(ptr_ + other); }
-                    ConstIterator operator-(int other) { return const_iterator(ptr_ - other); }
+                    reference operator[](difference_type n) const { return ptr_[n]; }
                     ConstIterator& operator++() { ++ptr_; return *this; }
                     ConstIterator operator++(int) { ConstIterator tmp = *this; ++ptr_; return tmp; }
                     ConstIterator& operator--() { --ptr_; return *this; }
                     ConstIterator operator--(int) { ConstIterator tmp = *this; --ptr_; return tmp; }
+                    ConstIterator& operator+=(difference_type n) { ptr_ += n; return *this; }
+                    ConstIterator& operator-=(difference_type n) { ptr_ -= n; return *this; }
+                    friend ConstIterator operator+(const ConstIterator& it, difference_type n) { return ConstIterator(it.ptr_ + n); }
+                    friend ConstIterator operator+(difference_type n, const ConstIterator& it) { return ConstIterator(it.ptr_ + n); }
+                    friend ConstIterator operator-(const ConstIterator& it, difference_type n) { return ConstIterator(it.ptr_ - n); }
+                    friend difference_type operator-(const ConstIterator& a, const ConstIterator& b) { return a.ptr_ - b.ptr_; }
                     bool operator==(const ConstIterator& other) const { return ptr_ == other.ptr_; }
-                    bool operator!=(const ConstIterator& other) const { return ptr_ != other.ptr_; }
+                    auto operator<=>(const ConstIterator& other) const { return ptr_ <=> other.ptr_; }
 
                 private:
                     pointer ptr_;
@@ -117,29 +481,60 @@ namespace com {
              * @brief Default constructor.
              * 
              */
-            vectormap() : capacity_(0), size_(0), data_(nullptr) {};
+            vectormap() noexcept(std::is_nothrow_default_constructible_v<allocator_type> && std::is_nothrow_default_constructible_v<index_type>) : capacity_(0), size_(0), data_(nullptr) {};
+
+            /**
+             * @brief Construct an empty vectormap object that allocates with a given allocator.
+             * 
+             * @param alloc Allocator of the elements.
+             */
+            explicit vectormap(const allocator_type& alloc) : allocator_(alloc) {};
 
             /**
              * @brief Construct a new vectormap object from a list.
              * 
-             * @param il List with the elements.
+             * @param il    List with the elements.
+             * @param alloc Allocator of the elements.
              */
-            vectormap(const std::initializer_list<value_type>& il);
+            vectormap(const std::initializer_list<value_type>& il, const allocator_type& alloc = allocator_type());
+
+            /**
+             * @brief Construct a new vectormap object from the elements in [first, last).\n
+             *        If the number of elements can be computed beforehand, they are stored with a single allocation.
+             * 
+             * @param first First element.
+             * @param last  End of the elements.
+             * @param alloc Allocator of the elements.
+             */
+            template<std::input_iterator It, std::sentinel_for<It> S>
+            requires std::constructible_from<std::pair<const key_, value_>, std::iter_reference_t<It>>
+            vectormap(It first, S last, const allocator_type& alloc = allocator_type()) : vectormap(alloc) { insert(0, std::move(first), std::move(last)); }
 
             /**
              * @brief Copy constructor.\n 
              *        Constructs a new vectormap object from another vectormap object.
+             *        The allocator is obtained with select_on_container_copy_construction.
              * 
              * @param other 
              */
-            vectormap(const vectormap& other);
+            vectormap(const vectormap& other) : vectormap(other, allocator_traits::select_on_container_copy_construction(other.allocator_)) {};
+            vectormap(const vectormap& other, const allocator_type& alloc);
 
             /**
-             * @brief Construct a new vectormap object
+             * @brief Move constructor.\n
+             *        The allocator is moved along with the elements.
+             * 
+             * @param other 
+             */
+            vectormap(vectormap&& other) noexcept((inline_ == 0) || nothrow_relocatable_);
+            /**
+             * @brief Moves the elements of another vectormap into a new one that allocates with alloc.\n
+             *        The elements are relocated one by one if alloc is not equal to the allocator of other.
              * 
              * @param other 
+             * @param alloc Allocator of the elements.
              */
-            vectormap(vectormap&& other) noexcept(allocator_traits::is_always_equal::value);
+            vectormap(vectormap&& other, const allocator_type& alloc);
             /** @} */
 
             // Destructor
@@ -149,10 +544,78 @@ namespace com {
             /** @name Element insertion
              */
             /** @{ */
-            iterator insert(const value_type& val, const size_type pos);
-            iterator insert(const key_type& key, const mapped_type& val, const size_type pos) { return insert(std::make_pair<>(key, val), pos); }
+            /**
+             * @brief Constructs an element in place at a given position.
+             * 
+             * @param pos        Position of the new element.
+             * @param args       Arguments forwarded to the constructor of the element.
+             * @return iterator  Iterator pointing to the added element, end() if pos is out of range.
+             */
+            template<class... Args>
+            iterator emplace(const size_type pos, Args&&... args);
+            template<class... Args>
+            iterator emplace_back(Args&&... args) { return emplace(size_, std::forward<Args>(args)...); }
+            template<class... Args>
+            iterator emplace_front(Args&&... args) { return emplace(0, std::forward<Args>(args)...); }
+            iterator insert(const value_type& val, const size_type pos) { return emplace(pos, val); }
+            iterator insert(value_type&& val, const size_type pos) { return emplace(pos, std::move(val)); }
+            iterator insert(const key_type& key, const mapped_type& val, const size_type pos) { return emplace(pos, key, val); }
+            iterator insert(key_type&& key, mapped_type&& val, const size_type pos) { return emplace(pos, std::move(key), std::move(val)); }
             iterator insert(const std::initializer_list<value_type>& il, const size_type pos);
-            iterator insert(const vectormap<key_type, mapped_type, delta_>& map, const size_type pos);
+            iterator insert(const vectormap& map, const size_type pos);
+            /**
+             * @brief Moves all the elements of another vectormap at a given position, leaving it empty.
+             * 
+             * @param map        vectormap whose elements are moved.
+             * @param pos        Position of the first moved element.
+             * @return iterator  Iterator pointing to the first moved element, end() if pos is out of range.
+             */
+            iterator insert(vectormap&& map, const size_type pos);
+            /**
+             * @brief Inserts the elements in [first, last) at a given position.\n
+             *        The number of elements is computed once, so the vectormap grows and shifts its elements only once.
+             *        A single-pass range is gathered in a temporary vectormap first.
+             *        The range must not refer to elements of this vectormap.
+             * 
+             * @param pos        Position of the first inserted element.
+             * @param first      First element.
+             * @param last       End of the elements.
+             * @return iterator  Iterator pointing to the first inserted element, end() if pos is out of range.
+             */
+            template<std::input_iterator It, std::sentinel_for<It> S>
+            requires std::constructible_from<value_type, std::iter_reference_t<It>>
+            iterator insert(const size_type pos, It first, S last);
+            /**
+             * @brief Inserts the elements of a range at a given position, like insert(pos, first, last).\n
+             *        The elements are moved from the range when it is an rvalue; an rvalue vectormap is relocated.
+             * 
+             * @param pos        Position of the first inserted element.
+             * @param range      Elements to insert.
+             * @return iterator  Iterator pointing to the first inserted element, end() if pos is out of range.
+             */
+            template<InsertableRange<std::pair<const key_, value_>> R>
+            iterator insert_range(const size_type pos, R&& range);
+            template<InsertableRange<std::pair<const key_, value_>> R>
+            iterator append_range(R&& range) { return insert_range(size_, std::forward<R>(range)); }
+            /**
+             * @brief Appends the elements of a range, like append_range, and writes their handles to out, with a stable index.\n
+             *        The handles held by the readers stay valid, so they do not have to look their elements up again.
+             * 
+             * @param range  Elements to append.
+             * @param out    Output iterator that receives the handle of every appended element, in order.
+             * @return O     Iterator past the last handle written.
+             */
+            template<InsertableRange<std::pair<const key_, value_>> R, std::output_iterator<const stable_handle&> O>
+            requires stable
+            O append_batch(R&& range, O out) {
+                const size_type first = size_;
+                append_range(std::forward<R>(range));
+                for (size_type i = first; i < size_; ++i) {
+                    *out = index_.handle(i);
+                    ++out;
+                }
+                return out;
+            }
             /**
              * @brief Adds an element at the end of the vectormap.
              * 
@@ -160,6 +623,7 @@ namespace com {
              * @return iterator  Iterator pointing to the added element.
              */
             iterator push_back(const value_type& val) { return insert(val, size_); }
+            iterator push_back(value_type&& val) { return insert(std::move(val), size_); }
             /**
              * @brief Adds an element at the end of the vectormap.
              * 
@@ -168,55 +632,270 @@ namespace com {
              * @return iterator  Iterator pointing to the added element.
              */
             iterator push_back(const key_type& key, const mapped_type& val) { return insert(key, val, size_); }
+            iterator push_back(key_type&& key, mapped_type&& val) { return insert(std::move(key), std::move(val), size_); }
             iterator push_back(const std::initializer_list<value_type>& il) { return insert(il, size_); }
-            iterator push_back(const vectormap<key_type, mapped_type, delta_>& map) { return insert(map, size_); }
+            iterator push_back(const vectormap& map) { return insert(map, size_); }
+            iterator push_back(vectormap&& map) { return insert(std::move(map), size_); }
             iterator push_front(const value_type& val) { return insert(val, 0); }
+            iterator push_front(value_type&& val) { return insert(std::move(val), 0); }
             iterator push_front(const key_type& key, const mapped_type& val) { return insert(key, val, 0); }
+            iterator push_front(key_type&& key, mapped_type&& val) { return insert(std::move(key), std::move(val), 0); }
             iterator push_front(const std::initializer_list<value_type>& il) { return insert(il, 0); }
-            iterator push_front(const vectormap<key_type, mapped_type, delta_>& map) { return insert(map, 0); }
+            iterator push_front(const vectormap& map) { return insert(map, 0); }
+            iterator push_front(vectormap&& map) { return insert(std::move(map), 0); }
             /** @} */
 
             /** @name Element access */
             /** @{ */
-            iterator get(const size_type pos) { return pos < size_ ? iterator(&data_[pos]) : end(); }
-            std::vector<iterator_pos> get(const key_type& key, size_type ordinal = 1, size_type number = 1);
-            std::vector<iterator_pos> get_all(const key_type& key);      
-            mapped_type& get_value(const size_type& pos) { return pos < size_ ? data_[pos].second : void_mapped_type_; }
-            std::vector<mapped_type> get_value(const key_type& key, size_type ordinal = 1, size_type number = 1);
-            std::vector<mapped_type> get_all_values(const key_type& key);
-            const key_type& get_key(const size_type& pos) { return pos < size_ ? data_[pos].first : void_key_type_; }
-            std::vector<size_type> get_pos(const key_type& key, size_type ordinal = 1, size_type number = 1);
-            std::vector<size_type> get_all_pos(const key_type& key);
+            iterator get(const size_type pos) requires positional_overloads { return get_at(pos); }
+            std::vector<iterator_pos> get(const key_type& key, size_type ordinal = 1, size_type number = 1) { return get<key_type>(key, ordinal, number); }
+            /**
+             * @brief Key lookups also accept any type comparable with the key (see KeyComparableWith),
+             *        e.g. a std::string_view or a literal for std::string keys, without building a key_type.\n
+             *        An index is used if it can look them up too (see hash_index), otherwise the elements are scanned.
+             */
+            template<KeyComparableWith<key_> K>
+            std::vector<iterator_pos> get(const K& key, size_type ordinal = 1, size_type number = 1);
+            std::vector<iterator_pos> get_all(const key_type& key) { return get_all<key_type>(key); }
+            template<KeyComparableWith<key_> K>
+            std::vector<iterator_pos> get_all(const K& key);
+            mapped_type& get_value(const size_type& pos) requires positional_overloads { return get_value_at(pos); }
+            const mapped_type& get_value(const size_type& pos) const requires positional_overloads { return get_value_at(pos); }
+            std::vector<mapped_type> get_value(const key_type& key, size_type ordinal = 1, size_type number = 1) const { return get_value<key_type>(key, ordinal, number); }
+            template<KeyComparableWith<key_> K>
+            std::vector<mapped_type> get_value(const K& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<mapped_type> get_all_values(const key_type& key) const { return get_all_values<key_type>(key); }
+            template<KeyComparableWith<key_> K>
+            std::vector<mapped_type> get_all_values(const K& key) const;
+            const key_type& get_key(const size_type& pos) const { return get_key_at(pos); }
+            std::vector<size_type> get_pos(const key_type& key, size_type ordinal = 1, size_type number = 1) const { return get_pos<key_type>(key, ordinal, number); }
+            template<KeyComparableWith<key_> K>
+            std::vector<size_type> get_pos(const K& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<size_type> get_all_pos(const key_type& key) const { return get_all_pos<key_type>(key); }
+            template<KeyComparableWith<key_> K>
+            std::vector<size_type> get_all_pos(const K& key) const;
+            /**
+             * @brief Position of the first element holding key at or after a given position.\n
+             *        Resuming from the last match plus one walks the matches without comparing again the elements before it,
+             *        e.g. to paginate a key that occurs many times. With an index it is a binary search of the positions of key.
+             * 
+             * @param key        Key to look for.
+             * @param from       First position looked at.
+             * @return size_type Position of the element, npos if there is none.
+             */
+            size_type find_next_pos(const key_type& key, size_type from) const { return find_next_pos<key_type>(key, from); }
+            template<KeyComparableWith<key_> K>
+            size_type find_next_pos(const K& key, size_type from) const;
+            /**
+             * @brief Calls f(pos) for every position in [first, last) holding key, in ascending order, until f returns false.\n
+             *        The range is always scanned, even if there is an index: it lets several threads look up disjoint ranges.
+             * 
+             * @param key     Key to look for.
+             * @param first   First position scanned.
+             * @param last    Position after the last one scanned, at most size().
+             * @param f       Function called with the position of every match.
+             * @return bool   false if f stopped the scan.
+             */
+            template<class F>
+            bool for_each_pos(const key_type& key, size_type first, size_type last, F&& f) const { return scan_range_(key, first, last, std::forward<F>(f)); }
+            /**
+             * @brief Element at a given position.\n
+             *        Unlike get(pos), it is never ambiguous with the key lookups.
+             * 
+             * @param pos        Position of the element.
+             * @return iterator  Iterator pointing to the element, end() if pos is out of range.
+             */
+            iterator get_at(const size_type pos) { return pos < size_ ? iterator(&data_[pos]) : end(); }
+            /**
+             * @brief Value and key of the element at a given position.\n
+             *        Out of range, the const overloads refer to a default constructed value and key shared by all the
+             *        vectormaps of the type, which are read only. The mutable value refers to a default constructed
+             *        value private to the calling thread, reset on every call, so that writes out of range are lost.
+             *        get_at returns end() out of range instead.
+             */
+            mapped_type& get_value_at(const size_type pos) { return pos < size_ ? data_[pos].second : discarded_value<mapped_type>(); }
+            const mapped_type& get_value_at(const size_type pos) const { return pos < size_ ? data_[pos].second : void_mapped_type_; }
+            const key_type& get_key_at(const size_type pos) const { return pos < size_ ? data_[pos].first : void_key_type_; }
+            reference operator[](const size_type pos) { return data_[pos]; }
+            const_reference operator[](const size_type pos) const { return data_[pos]; }
+            /**
+             * @brief Finds the first element with a given key.
+             * 
+             * @param key        Key to look for.
+             * @return iterator  Iterator pointing to the element, end() if there is none.
+             */
+            iterator find(const key_type& key) { return find_nth(key, 1); }
+            const_iterator find(const key_type& key) const { return find_nth(key, 1); }
+            template<KeyComparableWith<key_> K>
+            iterator find(const K& key) { return find_nth(key, 1); }
+            template<KeyComparableWith<key_> K>
+            const_iterator find(const K& key) const { return find_nth(key, 1); }
+            /**
+             * @brief Finds the ordinal-th element with a given key.
+             * 
+             * @param key        Key to look for.
+             * @param ordinal    Occurrence of the key, starting at 1.
+             * @return iterator  Iterator pointing to the element, end() if there is none.
+             */
+            iterator find_nth(const key_type& key, size_type ordinal) { return find_nth<key_type>(key, ordinal); }
+            const_iterator find_nth(const key_type& key, size_type ordinal) const { return find_nth<key_type>(key, ordinal); }
+            template<KeyComparableWith<key_> K>
+            iterator find_nth(const K& key, size_type ordinal) { size_type pos = find_pos_(key, ordinal); return pos != npos ? iterator(data_ + pos) : end(); }
+            template<KeyComparableWith<key_> K>
+            const_iterator find_nth(const K& key, size_type ordinal) const { size_type pos = find_pos_(key, ordinal); return pos != npos ? const_iterator(data_ + pos) : end(); }
+            size_type count(const key_type& key) const { return count<key_type>(key); }
+            template<KeyComparableWith<key_> K>
+            size_type count(const K& key) const;
+            bool contains(const key_type& key) const { return find_pos_(key, 1) != npos; }
+            template<KeyComparableWith<key_> K>
+            bool contains(const K& key) const { return find_pos_(key, 1) != npos; }
+            /**
+             * @brief Lazy view over the elements with a given key, in insertion order.\n
+             *        No container is built; it is invalidated like the iterators.
+             * 
+             * @param key   Key to look for.
+             * @return auto std::ranges view of references to the matching elements.
+             */
+            auto equal_range_view(const key_type& key) { return equal_range_view_<pointer>(key); }
+            auto equal_range_view(const key_type& key) const { return equal_range_view_<const_pointer>(key); }
+            template<KeyComparableWith<key_> K>
+            auto equal_range_view(const K& key) { return equal_range_view_<pointer>(key); }
+            template<KeyComparableWith<key_> K>
+            auto equal_range_view(const K& key) const { return equal_range_view_<const_pointer>(key); }
+            /**
+             * @brief View of the elements in ascending key order, equal keys by position, with an ordered index (see sorted_index).\n
+             *        The elements keep their insertion order; the view is invalidated like equal_range_view.
+             */
+            auto sorted_view() requires ordered { return order_view_<pointer>(index_.sorted().begin(), index_.sorted().end()); }
+            auto sorted_view() const requires ordered { return order_view_<const_pointer>(index_.sorted().begin(), index_.sorted().end()); }
+            /**
+             * @brief View of the elements whose key is in [first, last), in ascending key order, with an ordered index (see sorted_index).
+             *
+             * @param first  Smallest key of the range.
+             * @param last   Key after the range.
+             */
+            auto range_view(const key_type& first, const key_type& last) requires ordered { return range_view<key_type>(first, last); }
+            auto range_view(const key_type& first, const key_type& last) const requires ordered { return range_view<key_type>(first, last); }
+            template<KeyComparableWith<key_> K>
+            auto range_view(const K& first, const K& last) requires ordered { return order_view_<pointer>(index_.lower_bound(*this, first), index_.lower_bound(*this, last)); }
+            template<KeyComparableWith<key_> K>
+            auto range_view(const K& first, const K& last) const requires ordered { return order_view_<const_pointer>(index_.lower_bound(*this, first), index_.lower_bound(*this, last)); }
             pointer data() { return data_; }
+            const_pointer data() const { return data_; }
+            /**
+             * @brief Index used to speed up the key lookups.
+             * 
+             * @return const index_type&  Secondary index of the vectormap.
+             */
+            const index_type& index() const { return index_; }
+            /**
+             * @brief Handle of the element at a position, with a stable index (see stable_index).\n
+             *        Unlike the iterators and the positions, it keeps identifying the element until the element is erased.
+             * 
+             * @param pos             Position of the element.
+             * @return stable_handle  Handle of the element, a null handle if pos is out of range.
+             */
+            stable_handle handle_at(const size_type pos) const requires stable { return pos < size_ ? index_.handle(pos) : stable_handle(); }
+            /**
+             * @brief Element identified by a handle, in O(1).
+             * 
+             * @param handle      Handle returned by handle_at or append_batch.
+             * @return iterator   Iterator pointing to the element, end() if it has been erased.
+             */
+            iterator resolve(const stable_handle& handle) requires stable { return get_at(resolve_pos(handle)); }
+            const_iterator resolve(const stable_handle& handle) const requires stable { return get_at(resolve_pos(handle)); }
+            size_type resolve_pos(const stable_handle& handle) const requires stable { return index_.pos(handle); }
             /** @} */
 
             /** @name  Element modification */
             /** @{ */
-            void set(const value_type& new_value, const size_type pos) { data_[pos] = new_value; }
-            void set(const value_type& new_value, const key_type& key, size_type ordinal = 1) { get(key, ordinal).first = new_value; }
-            void set_value(const mapped_type& new_mapped_value, const size_type pos) { data_[pos].second = new_mapped_value; }
-            void set_value(const mapped_type& new_mapped_value, const key_type& key, size_type ordinal = 1){ get_value(key, ordinal) = new_mapped_value; }
-            void set_key(const key_type& new_key, const size_type pos) { data_[pos].first = new_key; }
-            void set_key(const key_type& new_key, const key_type& key, size_type ordinal = 1) { get(key, ordinal).first->first = new_key; }
+            void set(const value_type& new_value, const size_type pos) requires positional_overloads { set_at(new_value, pos); }
+            void set(const value_type& new_value, const key_type& key, size_type ordinal = 1) { set<key_type>(new_value, key, ordinal); }
+            template<KeyComparableWith<key_> K>
+            void set(const value_type& new_value, const K& key, size_type ordinal = 1);
+            void set_value(const mapped_type& new_mapped_value, const size_type pos) requires positional_overloads { set_value_at(new_mapped_value, pos); }
+            void set_value(const mapped_type& new_mapped_value, const key_type& key, size_type ordinal = 1) { set_value<key_type>(new_mapped_value, key, ordinal); }
+            template<KeyComparableWith<key_> K>
+            void set_value(const mapped_type& new_mapped_value, const K& key, size_type ordinal = 1);
+            void set_key(const key_type& new_key, const size_type pos) requires positional_overloads { set_key_at(new_key, pos); }
+            void set_key(const key_type& new_key, const key_type& key, size_type ordinal = 1) { set_key<key_type>(new_key, key, ordinal); }
+            template<KeyComparableWith<key_> K>
+            void set_key(const key_type& new_key, const K& key, size_type ordinal = 1);
+            void set_at(const value_type& new_value, const size_type pos);
+            void set_value_at(const mapped_type& new_mapped_value, const size_type pos) { if (pos < size_) data_[pos].second = new_mapped_value; }
+            void set_key_at(const key_type& new_key, const size_type pos);
+            /**
+             * @brief Calls fn with a reference to the value of every element, in order.
+             * 
+             * @param fn  Function called with (mapped_type&).
+             */
+            template<class F>
+            void for_each_value(F fn) { for (size_type i = 0; i < size_; ++i) fn(data_[i].second); }
             /** @} */
 
             /** @name  Element management */
             /** @{ */
             void clear();
-            void erase(const size_type pos);
-            void erase(const key_type& key) { erase(get(key).second);  }
-            void erase(const std::initializer_list<size_type>& il);
-            void erase_all(const key_type& key);
+            void erase(const size_type pos) requires positional_overloads { erase_at(pos); }
+            void erase(const key_type& key) { erase<key_type>(key); }
+            template<KeyComparableWith<key_> K>
+            void erase(const K& key);
+            void erase_at(const size_type pos);
+            /**
+             * @brief Erases the elements at the given positions, all referring to the vectormap before the erasure.
+             * 
+             * @param il  Positions of the elements to erase, in any order.
+             */
+            void erase(const std::initializer_list<size_type>& il) { erase_positions(std::span<const size_type>(il.begin(), il.size())); }
+            size_type erase_all(const key_type& key) { return erase_all<key_type>(key); }
+            template<KeyComparableWith<key_> K>
+            size_type erase_all(const K& key);
+            /**
+             * @brief Erases every element for which pred returns true, in a single pass.\n
+             *        The remaining elements keep their order and each one is moved at most once.
+             * 
+             * @param pred         Predicate called once per element, in order, with a const reference to it.
+             * @return size_type   Number of erased elements.
+             */
+            template<class P>
+            size_type erase_if(P pred) { return compact_([&](size_type i) { return static_cast<bool>(pred(std::as_const(data_[i]))); }); }
+            /**
+             * @brief Erases the elements at the given positions in a single pass.\n
+             *        All the positions refer to the vectormap before the erasure.
+             *        Duplicated and out of range positions are ignored.
+             * 
+             * @param positions    Positions of the elements to erase, preferably in ascending order (otherwise they are sorted in a copy).
+             * @return size_type   Number of erased elements.
+             */
+            size_type erase_positions(std::span<const size_type> positions);
+            /**
+             * @brief Moves the element at from to the position to, shifting the elements in between by one.\n
+             *        Only the elements between from and to are relocated, once.
+             * 
+             * @param from  Position of the element.
+             * @param to    Position of the element after the move.
+             */
             void move(const size_type from, const size_type to);
+            /**
+             * @brief Swaps the elements at two positions by relocating them, without copying either.
+             */
             void swap(const size_type from, const size_type to);
-            void swap(vectormap& a, vectormap& b);
+            /**
+             * @brief Swaps the contents of two vectormaps in O(1), unless one of them holds its elements inline.\n
+             *        The statistics follow the contents. The free swap(a, b) is found through ADL,
+             *        e.g. by std::sort or std::ranges::swap.
+             * 
+             * @param other  vectormap to swap with.
+             */
+            void swap(vectormap& other) noexcept(nothrow_swappable_);
+            friend void swap(vectormap& a, vectormap& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
             /** @} */
             
             /** @name  Memory manipulation */
             /** @{ */
-            size_type size() { return size_; }
-            size_type capacity() { return capacity_; }
-            bool is_empty() { return ((data_ == nullptr) || (size_ == 0)); }
+            size_type size() const { return size_; }
+            size_type capacity() const { return capacity_; }
+            bool is_empty() const { return ((data_ == nullptr) || (size_ == 0)); }
             bool reserve(size_type min_capacity);
             bool shrink() { return resize(size_); };
             bool resize(size_type new_capacity);
@@ -224,8 +903,52 @@ namespace com {
 
             /** @name  Operators */
             /** @{ */
+            /**
+             * @brief Copy assignment. If copying an element throws, the vectormap is left empty and valid.
+             */
             vectormap& operator=(const vectormap& other);
-            vectormap& operator=(vectormap&& other);
+            vectormap& operator=(vectormap&& other) noexcept((allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value) &&
+                                                             ((inline_ == 0) || nothrow_relocatable_));
+            /** @} */
+
+            allocator_type get_allocator() const { return allocator_; }
+
+            /** @name  Serialization */
+            /** @{ */
+            /**
+             * @brief Tells whether serialize and deserialize are available: the key and the value are bitwise serializable.
+             */
+            static constexpr bool serializable = is_bitwise_serializable<key_type>::value && is_bitwise_serializable<mapped_type>::value;
+            /**
+             * @brief Writes the vectormap as one contiguous blob: a serialized_header followed by the elements.\n
+             *        The blob can be loaded with deserialize or used in place by a vectormap_view.
+             * 
+             * @param writer  Callable with (const std::byte* data, size_t size), called once for the header and once for the elements.
+             */
+            template<std::invocable<const std::byte*, size_t> W>
+            void serialize(W&& writer) const requires serializable;
+            void serialize(std::ostream& out) const requires serializable {
+                serialize([&out](const std::byte* data, size_t size) { out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size)); });
+            }
+            /**
+             * @brief Replaces the elements with the ones of a blob written by serialize, with a single copy.
+             * 
+             * @param blob   Serialized vectormap.
+             * @return bool  false, leaving the vectormap unchanged, if the blob is not valid for this type.
+             */
+            bool deserialize(std::span<const std::byte> blob) requires serializable;
+            /** @} */
+
+            /** @name  Statistics */
+            /** @{ */
+            /**
+             * @brief Counters of the work done since the construction or the last reset_stats().\n
+             *        Only available with an enabled statistics policy; copies start from zero.
+             * 
+             * @return const vectormap_stats&  Current counters.
+             */
+            const vectormap_stats& stats() const requires statistics_type::enabled { return stats_; }
+            void reset_stats() requires statistics_type::enabled { static_cast<vectormap_stats&>(stats_) = vectormap_stats(); }
             /** @} */
 
             /** @name  Iterators */
@@ -241,10 +964,10 @@ namespace com {
             const_iterator cbegin() const { return const_iterator(data_); }
             const_iterator cend() const { return const_iterator(data_ + size_); }
 
-            const_reverse_iterator rbegin() const { return const_reverse_iterator(data_); }
-            const_reverse_iterator rend() const { return const_reverse_iterator(data_ + size_); }
-            const_reverse_iterator crbegin() const { return const_reverse_iterator(data_ + size_); }
-            const_reverse_iterator crbend() const { return const_reverse_iterator(data_); }
+            const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+            const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+            const_reverse_iterator crbegin() const { return rbegin(); }
+            const_reverse_iterator crend() const { return rend(); }
 
             iterator last() { return iterator(data_ + size_ - 1); }
             const_iterator last() const { return const_iterator(data_ + size_ - 1); }
@@ -253,112 +976,354 @@ namespace com {
             
 
         private:
-            allocator_type allocator_;
+            // With the default policies, all but the three words of the buffer take no room.
+            [[no_unique_address]] allocator_type allocator_;
             size_type size_ = 0;
             size_type capacity_ = 0;
             pointer data_ = nullptr;
-            mapped_type void_mapped_type_;
-            key_type void_key_type_;
-            bool gap_(size_type from, size_type length);
+            [[no_unique_address]] front_room<front_gap_enabled> front_;
+            [[no_unique_address]] index_type index_;
+            [[no_unique_address]] inline_buffer<value_type, inline_> inline_buffer_;
+            [[no_unique_address]] mutable statistics_type stats_;
+            // Returned by the accessors out of range, shared by all the vectormaps of the same type: read only, so that they never race.
+            static inline const mapped_type void_mapped_type_{};
+            static inline const key_type void_key_type_{};
+            static constexpr bool trivially_relocatable_ = is_trivially_relocatable<key_type>::value && is_trivially_relocatable<mapped_type>::value;
+            // Whether the growth policy releases memory after erasures (see auto_shrink).
+            static constexpr bool auto_shrink_ = requires { { growth_type::shrink(size_type(), size_type(), size_type()) } -> std::convertible_to<size_type>; };
+            // Swapping two maps only exchanges their pointers, unless the elements of one of them are inline.
+            static constexpr bool nothrow_swappable_ = ((inline_ == 0) || std::is_nothrow_move_constructible_v<value_type>) && std::is_nothrow_swappable_v<index_type>;
+            static constexpr bool nothrow_relocatable_ = trivially_relocatable_ ||
+                                                         (std::is_nothrow_move_constructible_v<key_type> && std::is_nothrow_move_constructible_v<mapped_type>);
+
+            /**
+             * @brief Opens room for length elements at from and calls construct(dst) to build them there.\n
+             *        If construct throws, it must destroy the elements it built; the vectormap is then left unchanged.
+             *        When the buffer grows, the elements are built in the new buffer before the others are relocated,
+             *        so they can still be copied from the vectormap itself. Elements that are not nothrow relocatable
+             *        always go to a new buffer when others must be shifted.
+             */
+            template<class F>
+            bool gap_(size_type from, size_type length, F&& construct);
+            template<class It>
+            iterator insert_n_(size_type pos, It first, size_type length);
+            template<class It>
+            void construct_n_(pointer dst, It first, size_type length);
+            // Builds copies of n elements at dst, or moves them if they cannot be copied; the caller destroys src.
+            // With copies, a throw leaves src unchanged.
+            void transfer_n_(pointer dst, pointer src, size_type n) {
+                if constexpr (std::is_copy_constructible_v<value_type>) {
+                    construct_n_(dst, static_cast<const_pointer>(src), n);
+                }
+                else {
+                    construct_n_(dst, std::make_move_iterator(src), n);
+                }
+            }
+            void relocate_(pointer dst, pointer src, size_type n);
+            /**
+             * @brief Relocates the elements to a new buffer, leaving length free elements at from.\n
+             *        Strong guarantee: if an element throws while being copied, the copies are destroyed and the vectormap
+             *        keeps its buffer; new_data is not released. The elements are moved instead when that cannot throw.
+             */
+            void adopt_(pointer new_data, size_type new_capacity, size_type from, size_type length, size_type head = 0);
+            // Destroys the elements, keeping the buffer.
+            void clear_();
+            // Lets the growth policy release the memory that the erasures left unused (see auto_shrink).
+            void shrink_if_sparse_();
+            void open_front_(size_type length);
+            pointer allocate_(size_type min_capacity, size_type& new_capacity);
+            void deallocate_(pointer p, size_type capacity);
+            void release_();
+            void steal_(vectormap& other);
+            template<class K>
+            size_type find_pos_(const K& key, size_type ordinal) const;
+
+            /**
+             * @brief Erases the elements at the positions for which remove(pos) returns true, in ascending order.\n
+             *        Kept runs are relocated at once; if remove throws, the elements not visited yet are kept.
+             */
+            template<class F>
+            size_type compact_(F&& remove);
+
+            /**
+             * @brief Calls f(pos) for every position holding key, in ascending order,
+             *        until f returns false.
+             */
+            template<class K, class F>
+            void for_each_pos_(const K& key, F&& f) const;
+            /**
+             * @brief Like for_each_pos_, but starting at the ordinal-th occurrence of key.\n
+             *        An index jumps to it, a scan still has to count the occurrences before it.
+             */
+            template<class K, class F>
+            void for_each_pos_from_(const K& key, size_type ordinal, F&& f) const;
+            template<class K, class F>
+            void scan_(const K& key, F&& f) const;
+            template<class K, class F>
+            bool scan_range_(const K& key, size_type first, size_type last, F&& f) const;
+
+            // Whether the index can look up a K, otherwise the lookups of a K scan the elements.
+            template<class K>
+            static constexpr bool indexed_ = index_type::enabled && requires(const index_type& index, const K& key) { index.positions(key); };
+            // Whether the index keeps the positions sorted by key and can search them for a K.
+            template<class K>
+            static constexpr bool ordered_ = ordered && requires(const index_type& index, const vectormap& map, const K& key) { index.equal_range(map, key); };
+            // Whether the index is told which elements a compaction removed, instead of being rebuilt.
+            static constexpr bool compacts_ = requires(index_type& index, const vectormap& map, const std::vector<bool>& removed) { index.compacted(map, removed); };
+            // Whether the index can skip the elements that cannot hold a K during a scan.
+            template<class K>
+            static constexpr bool filtered_ = requires { requires index_type::template filters<K>; };
+
+            template<class pointer_, class K>
+            auto equal_range_view_(const K& key) const {
+                pointer_ data = data_;
+                if constexpr (indexed_<K>) {
+                    static const std::vector<size_type> none_;
+                    const std::vector<size_type>* positions = index_.positions(key);
+                    return std::views::all(positions != nullptr ? *positions : none_)
+                        | std::views::transform([data](size_type i) -> decltype(*data) { return data[i]; });
+                }
+                else {
+                    return std::ranges::subrange(data, data + size_)
+                        | std::views::filter([key](const value_type& elem) { return elem.first == key; });
+                }
+            }
+
+            template<class pointer_, class It>
+            auto order_view_(It first, It last) const {
+                pointer_ data = data_;
+                if (first > last) {
+                    last = first;
+                }
+                return std::ranges::subrange(first, last)
+                    | std::views::transform([data](size_type i) -> decltype(*data) { return data[i]; });
+            }
     };
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    vectormap<key_, value_, delta_>::vectormap(const std::initializer_list<value_type>& il) : capacity_(delta_), size_(0) {
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::vectormap(const std::initializer_list<value_type>& il, const allocator_type& alloc) : allocator_(alloc), capacity_(delta_), size_(0) {
         if (capacity_ < il.size()) {
             capacity_ = ((il.size() / delta_) + 1) * delta_;
         }
 
-        data_ = allocator_traits::allocate(allocator_, capacity_);
-
-        size_type counter = 0;
-        for (auto elem : il) {
-            allocator_traits::construct(allocator_, data_ + counter, elem);
-            size_++;
-            counter++;
+        data_ = allocate_(il.size(), capacity_);
+        try {
+            construct_n_(data_, il.begin(), il.size());
+            size_ = il.size();
+            index_.inserted(*this, 0, size_);
         }
-    }
-
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    vectormap<key_, value_, delta_>::vectormap(const vectormap &other) : capacity_(other.capacity_), size_(other.size_) {
-        data_ = allocator_traits::allocate(allocator_, capacity_);
-
-        for (size_type i = 0; i < size_; ++i) {
-            allocator_traits::construct(allocator_, data_ + i, std::make_pair(other.data_[i].first, other.data_[i].second));
+        catch (...) {
+            // The destructor does not run for a constructor that throws.
+            clear_();
+            release_();
+            throw;
         }
+        stats_.grown(size_);
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    vectormap<key_, value_, delta_>::vectormap(vectormap &&other) noexcept(allocator_traits::is_always_equal::value) {
-        if (allocator_traits::propagate_on_container_move_assignment::value) {
-            allocator_ = std::move(other.allocator_);
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::vectormap(const vectormap &other, const allocator_type& alloc) : allocator_(alloc), capacity_(other.capacity_), size_(other.size_), index_(other.index_) {
+        data_ = allocate_(size_, capacity_);
+        try {
+            construct_n_(data_, other.data_, size_);
         }
-        else {
-            allocator_ = other.allocator_;
+        catch (...) {
+            size_ = 0;
+            release_();
+            throw;
         }
-
-        data_ = std::exchange(other.data_, nullptr);
-        size_ = std::exchange(other.size_, 0);
-        capacity_ = std::exchange(other.capacity_, 0);
+        stats_.grown(size_);
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    vectormap<key_, value_, delta_>::~vectormap() {
-        for (size_type i = 0; i < size_; i++) {
-            allocator_traits::destroy(allocator_, data_ + i);
-        }
-
-        allocator_traits::deallocate(allocator_, data_, capacity_);
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::vectormap(vectormap &&other) noexcept((inline_ == 0) || nothrow_relocatable_) : allocator_(std::move(other.allocator_)) {
+        steal_(other);
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_> 
-    vectormap<key_, value_, delta_>::iterator vectormap<key_, value_, delta_>::insert(const value_type &val, const size_type pos) {
-        if (pos > size_) {
-            return end();
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::vectormap(vectormap &&other, const allocator_type& alloc) : allocator_(alloc) {
+        if (allocator_ == other.allocator_) {
+            steal_(other);
         }
         else {
-            bool success = gap_(pos, 1);
-            
-            if (success) {            
-                allocator_traits::construct(allocator_, data_ + pos, val);
-                return iterator(&data_[pos]);
-            }
-            else {
-                return end();
-            }
+            insert(std::move(other), 0);
         }
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    vectormap<key_, value_, delta_>::iterator vectormap<key_, value_, delta_>::insert(const std::initializer_list<value_type>& il, const size_type pos) {
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::~vectormap() {
+        clear_();
+        release_();
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class... Args>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::emplace(const size_type pos, Args&&... args) {
         if (pos > size_) {
             return end();
         }
-        else {
-            bool success = gap_(pos, il.size());
-            if (success) {        
-                for (size_type i = 0; i < il.size(); i++) {
-                    allocator_traits::construct(allocator_, data_ + pos + i, *(il.begin() + i));
+
+        if constexpr (front_gap_enabled && nothrow_relocatable_) {
+            if (pos < size_ - pos) {
+                // Closer to the front: shift the elements before pos into the head room.
+                alignas(value_type) unsigned char buffer[sizeof(value_type)];
+                pointer temp_ = reinterpret_cast<pointer>(buffer);
+                allocator_traits::construct(allocator_, temp_, std::forward<Args>(args)...);
+                try {
+                    open_front_(1);
+                }
+                catch (...) {
+                    allocator_traits::destroy(allocator_, temp_);
+                    throw;
                 }
+                relocate_(data_ - 1, data_, pos);
+                --data_;
+                ++capacity_;
+                front_.set(front_.get() - 1);
+                relocate_(data_ + pos, temp_, 1);
+
+                ++size_;
+                stats_.grown(size_);
+                index_.inserted(*this, pos, 1);
                 return iterator(data_ + pos);
             }
-            else {
-                return end();
-            }
         }
-    }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    vectormap<key_, value_, delta_>::iterator vectormap<key_, value_, delta_>::insert(const vectormap<key_type, mapped_type, delta_>& map, const size_type pos) {
-        if (pos > size_) {
-            return end();
+        if ((size_ == capacity_) || (!nothrow_relocatable_ && (pos < size_))) {
+            // Construct the element before relocating, args may refer to the elements of the vectormap.
+            // Elements whose relocation may throw are copied to a new buffer instead of being shifted in place.
+            size_type new_capacity = (size_ == capacity_) ? growth_type::grow(capacity_, size_ + 1, delta_) : capacity_;
+            pointer new_data = allocate_(size_ + 1, new_capacity);
+            try {
+                allocator_traits::construct(allocator_, new_data + pos, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                deallocate_(new_data, new_capacity);
+                throw;
+            }
+            try {
+                adopt_(new_data, new_capacity, pos, 1);
+            }
+            catch (...) {
+                allocator_traits::destroy(allocator_, new_data + pos);
+                deallocate_(new_data, new_capacity);
+                throw;
+            }
+        }
+        else if (pos == size_) {
+            allocator_traits::construct(allocator_, data_ + pos, std::forward<Args>(args)...);
         }
         else {
-            bool success = gap_(pos, map.size_);
-            if (success) {                
-                for (size_type i = 0; i < map.size_; i++) {
-                    allocator_traits::construct(allocator_, data_ + pos + i, 
-                        std::make_pair<>(map.data_[i].first, map.data_[i].second));
-                }
+            alignas(value_type) unsigned char buffer[sizeof(value_type)];
+            pointer temp_ = reinterpret_cast<pointer>(buffer);
+            allocator_traits::construct(allocator_, temp_, std::forward<Args>(args)...);
+            relocate_(data_ + pos + 1, data_ + pos, size_ - pos);
+            relocate_(data_ + pos, temp_, 1);
+        }
+
+        ++size_;
+        stats_.grown(size_);
+        index_.inserted(*this, pos, 1);
+        return iterator(data_ + pos);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::insert(const std::initializer_list<value_type>& il, const size_type pos) {
+        return insert(pos, il.begin(), il.end());
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<std::input_iterator It, std::sentinel_for<It> S>
+    requires std::constructible_from<typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::value_type, std::iter_reference_t<It>>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::insert(const size_type pos, It first, S last) {
+        if (pos > size_) {
+            return end();
+        }
+
+        if constexpr (std::forward_iterator<It> || std::sized_sentinel_for<S, It>) {
+            const size_type length = static_cast<size_type>(std::ranges::distance(first, last));
+            return insert_n_(pos, std::move(first), length);
+        }
+        else {
+            // The elements can only be read once: gather them before opening the gap.
+            vectormap temp(allocator_);
+            for (; first != last; ++first) {
+                temp.emplace_back(*first);
+            }
+            return insert(std::move(temp), pos);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<InsertableRange<std::pair<const key_, value_>> R>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::insert_range(const size_type pos, R&& range) {
+        constexpr bool movable = !std::is_lvalue_reference_v<R>;
+
+        if constexpr (movable && std::is_same_v<std::remove_cvref_t<R>, vectormap>) {
+            return insert(std::move(range), pos);
+        }
+        else if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+            if (pos > size_) {
+                return end();
+            }
+            const size_type length = static_cast<size_type>(std::ranges::distance(range));
+            if constexpr (movable) {
+                return insert_n_(pos, std::make_move_iterator(std::ranges::begin(range)), length);
+            }
+            else {
+                return insert_n_(pos, std::ranges::begin(range), length);
+            }
+        }
+        else if constexpr (movable) {
+            return insert(pos, std::make_move_iterator(std::ranges::begin(range)), std::move_sentinel(std::ranges::end(range)));
+        }
+        else {
+            return insert(pos, std::ranges::begin(range), std::ranges::end(range));
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class It>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::insert_n_(size_type pos, It first, size_type length) {
+        // A single gap for the whole batch, where the elements are constructed in place.
+        if (!gap_(pos, length, [&](pointer dst) { construct_n_(dst, first, length); })) {
+            return end();
+        }
+        index_.inserted(*this, pos, length);
+        return iterator(data_ + pos);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class It>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::construct_n_(pointer dst, It first, size_type length) {
+        size_type i = 0;
+        try {
+            for (; i < length; ++i, ++first) {
+                allocator_traits::construct(allocator_, dst + i, *first);
+            }
+        }
+        catch (...) {
+            for (size_type j = 0; j < i; ++j) {
+                allocator_traits::destroy(allocator_, dst + j);
+            }
+            throw;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::insert(const vectormap& map, const size_type pos) {
+        if (pos > size_) {
+            return end();
+        }
+        else {
+            if (&map == this) {
+                // The gap would move the elements being copied.
+                return insert(vectormap(map), pos);
+            }
+            const size_type count = map.size_;
+            bool success = gap_(pos, count, [&](pointer dst) { construct_n_(dst, static_cast<const_pointer>(map.data_), count); });
+            if (success) {
+                index_.inserted(*this, pos, count);
                 return iterator(data_ + pos);
             }
             else {
@@ -367,243 +1332,899 @@ namespace com {
         }
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    std::vector<typename vectormap<key_, value_, delta_>::iterator_pos> vectormap<key_, value_, delta_>::get(const key_type& key, const size_type ordinal, size_type number) {
-        std::vector<iterator_pos> out;
-        size_type order = 1;
-        
-        for (size_type i = 0; i < size_; ++i) {
-            if (data_[i].first == key) {
-                if ((order >= ordinal) && (out.size() == (number - 1))) {
-                    out.push_back(std::make_pair(iterator(&data_[i]), i));
-                    return std::move(out);
-                }
-                else if (order >= ordinal) {
-                    out.push_back(std::make_pair(iterator(&data_[i]), i));
-                    ++order;
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::insert(vectormap&& map, const size_type pos) {
+        if ((pos > size_) || (&map == this)) {
+            return end();
+        }
+        else {
+            // The elements are copied if moving them may throw, and destroyed in map only once they are all in place.
+            const size_type count = map.size_;
+            bool success = gap_(pos, count, [&](pointer dst) {
+                if constexpr (nothrow_relocatable_) {
+                    relocate_(dst, map.data_, count);
                 }
                 else {
-                    ++order;
+                    transfer_n_(dst, map.data_, count);
+                    for (size_type i = 0; i < count; ++i) {
+                        allocator_traits::destroy(allocator_, map.data_ + i);
+                    }
                 }
+            });
+            if (success) {
+                map.size_ = 0;
+                map.index_.cleared();
+                index_.inserted(*this, pos, count);
+                return iterator(data_ + pos);
+            }
+            else {
+                return end();
             }
         }
+    }
 
-        return std::move(out);
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    std::vector<typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator_pos> vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::get(const K& key, const size_type ordinal, size_type number) {
+        std::vector<iterator_pos> out;
+        for_each_pos_from_(key, ordinal, [&](size_type i) {
+            out.push_back(std::make_pair(iterator(&data_[i]), i));
+            return out.size() < number;
+        });
+
+        return out;
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    std::vector<typename vectormap<key_, value_, delta_>::iterator_pos> vectormap<key_, value_, delta_>::get_all(const key_type& key) {
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    std::vector<typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::iterator_pos> vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::get_all(const K& key) {
         std::vector<iterator_pos> out;
-        for (size_type i = 0; i < size_; i++)
-            if (data_[i].first == key) {
-                out.push_back(std::make_pair<>(&data_[i], i));
-            }
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(std::make_pair<>(iterator(&data_[i]), i));
+            return true;
+        });
 
         return out;
     }
 
-    template <DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    inline std::vector<typename vectormap<key_, value_, delta_>::mapped_type> vectormap<key_, value_, delta_>::get_value(const key_type &key, size_type ordinal, size_type number)
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    std::vector<typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::mapped_type> vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::get_value(const K& key, size_type ordinal, size_type number) const
     {
         std::vector<mapped_type> out;
-        std::vector<iterator_pos> get_ = get(key, ordinal, number);
-
-        for (size_type i = 0; i < get_.size(); ++i) {
-            out.push_back(get_.at(i).first->second);
-        }
+        for_each_pos_from_(key, ordinal, [&](size_type i) {
+            out.push_back(data_[i].second);
+            return out.size() < number;
+        });
 
-        return std::move(out);
+        return out;
     }
 
-    template <DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    std::vector<typename vectormap<key_, value_, delta_>::mapped_type> vectormap<key_, value_, delta_>::get_all_values(const key_type &key)
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    std::vector<typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::mapped_type> vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::get_all_values(const K& key) const
     {
         std::vector<mapped_type> out;
-        for (auto elem : get_all(key)) {
-            out.push_back(elem.first->second);
-        }
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(data_[i].second);
+            return true;
+        });
 
         return out;
     }
 
-    template <DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    inline std::vector<typename vectormap<key_, value_, delta_>::size_type> vectormap<key_, value_, delta_>::get_pos(const key_type &key, size_type ordinal, size_type number)
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    std::vector<typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::size_type> vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::get_pos(const K& key, size_type ordinal, size_type number) const
     {
-        std::vector<mapped_type> out;
-        std::vector<iterator_pos> get_ = get(key, ordinal, number);
-
-        for (size_type i = 0; i < get_.size(); ++i) {
-            out.push_back(get_.at(i).second);
-        }
+        std::vector<size_type> out;
+        for_each_pos_from_(key, ordinal, [&](size_type i) {
+            out.push_back(i);
+            return out.size() < number;
+        });
 
-        return std::move(out);
+        return out;
     }
 
-    template <DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    inline std::vector<typename vectormap<key_, value_, delta_>::size_type> vectormap<key_, value_, delta_>::get_all_pos(const key_type &key)
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    std::vector<typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::size_type> vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::get_all_pos(const K& key) const
     {
         std::vector<size_type> out;
-        for (auto elem : get_all(key)) {
-            out.push_back(elem.second);
-        }
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(i);
+            return true;
+        });
 
         return out;
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    void vectormap<key_, value_, delta_>::clear() {
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::size_type vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::find_next_pos(const K& key, size_type from) const {
+        if constexpr (indexed_<K>) {
+            const std::vector<size_type>* positions = index_.positions(key);
+            if (positions == nullptr) {
+                stats_.looked_up(0);
+                return npos;
+            }
+            auto it = std::lower_bound(positions->begin(), positions->end(), from);
+            stats_.looked_up(it != positions->end() ? 1 : 0);
+            return it != positions->end() ? *it : npos;
+        }
+        else {
+            size_type out = npos;
+            if (from < size_) {
+                scan_range_(key, from, size_, [&](size_type i) {
+                    out = i;
+                    return false;
+                });
+            }
+            stats_.looked_up(from < size_ ? (out != npos ? out + 1 : size_) - from : 0);
+            return out;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::size_type vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::count(const K& key) const {
+        if constexpr (indexed_<K>) {
+            const std::vector<size_type>* positions = index_.positions(key);
+            stats_.looked_up(0);
+            return positions != nullptr ? positions->size() : 0;
+        }
+        else {
+            size_type out = 0;
+            for_each_pos_(key, [&](size_type) {
+                ++out;
+                return true;
+            });
+            return out;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::set_at(const value_type& new_value, const size_type pos) {
+        if ((pos < size_) && (&new_value != data_ + pos)) {
+            // The new element is built aside, so that the element and the index are left unchanged if a copy throws.
+            alignas(value_type) unsigned char buffer[sizeof(value_type)];
+            pointer temp = reinterpret_cast<pointer>(buffer);
+            allocator_traits::construct(allocator_, temp, new_value);
+            try {
+                index_.key_changing(*this, pos, new_value.first);
+            }
+            catch (...) {
+                allocator_traits::destroy(allocator_, temp);
+                throw;
+            }
+            allocator_traits::destroy(allocator_, data_ + pos);
+            relocate_(data_ + pos, temp, 1);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::set(const value_type& new_value, const K& key, size_type ordinal) {
+        set_at(new_value, find_pos_(key, ordinal));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::set_value(const mapped_type& new_mapped_value, const K& key, size_type ordinal) {
+        size_type pos = find_pos_(key, ordinal);
+        if (pos != npos) {
+            data_[pos].second = new_mapped_value;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::set_key_at(const key_type& new_key, const size_type pos) {
+        if (pos < size_) {
+            // The new element is built aside; its value is moved only if that cannot throw, so that it can be moved back.
+            alignas(value_type) unsigned char buffer[sizeof(value_type)];
+            pointer temp = reinterpret_cast<pointer>(buffer);
+            allocator_traits::construct(allocator_, temp, new_key, std::move_if_noexcept(data_[pos].second));
+            try {
+                index_.key_changing(*this, pos, new_key);
+            }
+            catch (...) {
+                if constexpr (std::is_nothrow_move_constructible_v<mapped_type>) {
+                    std::destroy_at(&data_[pos].second);
+                    std::construct_at(&data_[pos].second, std::move(temp->second));
+                }
+                allocator_traits::destroy(allocator_, temp);
+                throw;
+            }
+            allocator_traits::destroy(allocator_, data_ + pos);
+            relocate_(data_ + pos, temp, 1);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::set_key(const key_type& new_key, const K& key, size_type ordinal) {
+        set_key_at(new_key, find_pos_(key, ordinal));
+    }
+
+template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::clear() {
+        clear_();
+        shrink_if_sparse_();
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::clear_() {
         for (size_type i = 0; i < size_; i++)
             allocator_traits::destroy(allocator_, data_ + i);
         size_ = 0;
+        if constexpr (front_gap_enabled) {
+            data_ -= front_.get();
+            capacity_ += front_.get();
+            front_.set(0);
+        }
+        index_.cleared();
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    void vectormap<key_, value_, delta_>::erase(const size_type pos) {
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::erase_at(const size_type pos) {
         if ((size_ > 0) && (pos < size_)) {
-            --size_;
-            for (size_type i = pos; i < size_; ++i) {
-                allocator_traits::destroy(allocator_, data_ + i);
-                allocator_traits::construct(allocator_, data_ + i, std::move(data_[i + 1]));
+            index_.erasing(*this, pos, 1);
+            allocator_traits::destroy(allocator_, data_ + pos);
+            if constexpr (front_gap_enabled) {
+                if (pos < size_ - 1 - pos) {
+                    // Closer to the front: shift the elements before pos, leaving the hole in the head room.
+                    relocate_(data_ + 1, data_, pos);
+                    ++data_;
+                    --capacity_;
+                    front_.set(front_.get() + 1);
+                    --size_;
+                    shrink_if_sparse_();
+                    return;
+                }
             }
+            relocate_(data_ + pos, data_ + pos + 1, size_ - pos - 1);
+            --size_;
+            shrink_if_sparse_();
         }
     }
 
-    template <DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    inline void vectormap<key_, value_, delta_>::erase(const std::initializer_list<size_type> &il) {
-        for (auto elem : il) {
-            erase(elem);
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::erase(const K& key) {
+        erase_at(find_pos_(key, 1));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::size_type vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::erase_positions(std::span<const size_type> positions) {
+        std::vector<size_type> sorted;
+        if (!std::is_sorted(positions.begin(), positions.end())) {
+            sorted.assign(positions.begin(), positions.end());
+            std::sort(sorted.begin(), sorted.end());
+            positions = sorted;
         }
+
+        auto it = positions.begin();
+        return compact_([&](size_type i) {
+            while ((it != positions.end()) && (*it < i)) {
+                ++it;
+            }
+            return (it != positions.end()) && (*it == i);
+        });
     }
 
-    template <DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    void vectormap<key_, value_, delta_>::erase_all(const key_type &key)
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<KeyComparableWith<key_> K>
+    typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::size_type vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::erase_all(const K& key)
     {
-        auto v = get_all(key);
-        for (auto it = v.rbegin(); it != v.rend(); ++it) {
-            erase(it->second);
+        if constexpr (indexed_<K>) {
+            const std::vector<size_type>* positions = index_.positions(key);
+            return positions != nullptr ? erase_positions(*positions) : 0;
+        }
+        else {
+            return compact_([&](size_type i) { return data_[i].first == key; });
         }
     }
 
-    template <DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    inline void vectormap<key_, value_, delta_>::move(const size_type from, const size_type to) {
-        if ((from < size_) && (to < size_)) {
-            gap_(to, 1);
-            allocator_traits::construct(allocator_, data_ + to, std::move(data_[from + 1]));
-            allocator_traits::destroy(allocator_, data_ + from + 1);
-            for (size_type i = from + 1; i < size_; ++i) {
-                allocator_traits::construct(allocator_, data_ + i, std::move(data_[i + 1]));
-                allocator_traits::destroy(allocator_, data_ + i + 1);
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    inline void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::move(const size_type from, const size_type to) {
+        if ((from < size_) && (to < size_) && (from != to)) {
+            alignas(value_type) unsigned char buffer[sizeof(value_type)];
+            pointer temp_ = reinterpret_cast<pointer>(buffer);
+
+            relocate_(temp_, data_ + from, 1);
+            if (from < to) {
+                relocate_(data_ + from, data_ + from + 1, to - from);
             }
-            --size_;
-        }        
+            else {
+                relocate_(data_ + to + 1, data_ + to, from - to);
+            }
+            relocate_(data_ + to, temp_, 1);
+
+            index_.moved(*this, from, to);
+        }
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    inline void vectormap<key_, value_, delta_>::swap(const size_type from, const size_type to)
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    inline void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::swap(const size_type from, const size_type to)
     {
-        if ((from < size_) && (to < size_)) {
-            value_type temp_ = data_[to];
-
-            allocator_traits::destroy(allocator_, data_ + to);
-            allocator_traits::construct(allocator_, data_ + to, std::move(data_[from]));
-            allocator_traits::destroy(allocator_, data_ + from);
-            allocator_traits::construct(allocator_, data_ + from, temp_);
+        if ((from < size_) && (to < size_) && (from != to)) {
+            alignas(value_type) unsigned char buffer[sizeof(value_type)];
+            pointer temp_ = reinterpret_cast<pointer>(buffer);
+
+            relocate_(temp_, data_ + to, 1);
+            relocate_(data_ + to, data_ + from, 1);
+            relocate_(data_ + from, temp_, 1);
+            index_.swapped(*this, from, to);
         }
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_> 
-    inline void vectormap<key_, value_, delta_>::swap(vectormap &a, vectormap &b) {
-        std::swap(a.allocator_, b.allocator_);
-        std::swap(a.data_, b.data_);
-        std::swap(a.size_, b.size_);
-        std::swap(a.capacity_, b.capacity_);
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    inline void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::swap(vectormap& other) noexcept(nothrow_swappable_) {
+        if (this == &other) {
+            return;
+        }
+        std::swap(stats_, other.stats_);
+        if constexpr (inline_ > 0) {
+            if (inline_buffer_.holds(data_) || other.inline_buffer_.holds(other.data_)) {
+                // Inline elements cannot change hands with their storage.
+                vectormap temp(std::move(*this));
+                *this = std::move(other);
+                other = std::move(temp);
+                return;
+            }
+        }
+
+        // Swapping the storage of unequal allocators that do not propagate is undefined, as for the standard containers.
+        if constexpr (allocator_traits::propagate_on_container_swap::value) {
+            std::swap(allocator_, other.allocator_);
+        }
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(front_, other.front_);
+        std::swap(index_, other.index_);
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    inline bool vectormap<key_, value_, delta_>::reserve(size_type min_capacity) {
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    inline bool vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::reserve(size_type min_capacity) {
         if (min_capacity < size_)
             return false;
 
+        if constexpr (inline_ > 0) {
+            // Rounding up to delta would move elements that fit in the inline buffer to the heap.
+            if (min_capacity <= inline_) {
+                return resize(min_capacity);
+            }
+        }
+
         size_type new_capacity = ((min_capacity / delta_) + 1) * delta_;
         return resize(new_capacity);
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    bool vectormap<key_, value_, delta_>::resize(size_type new_capacity) {
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    bool vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::resize(size_type new_capacity) {
+        stats_.resizing();
         if (new_capacity < size_)
             return false;
 
-        pointer new_data = allocator_traits::allocate(allocator_, new_capacity);
-        for (size_type i = 0; i < size_ ; i++) {
-            allocator_traits::construct(allocator_, new_data + i, data_[i]);
-            allocator_traits::destroy(allocator_, data_ + i);
-        }
-        
-        if (size_ != 0) {
-            allocator_traits::deallocate(allocator_, data_, capacity_);
+        if (inline_buffer_.holds(data_) && (new_capacity <= inline_)) {
+            return true;
         }
 
-        data_ = new_data;
-        capacity_ = new_capacity;
-
+        pointer new_data = allocate_(new_capacity, new_capacity);
+        try {
+            adopt_(new_data, new_capacity, size_, 0);
+        }
+        catch (...) {
+            deallocate_(new_data, new_capacity);
+            throw;
+        }
         return true;
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    vectormap<key_, value_, delta_> &vectormap<key_, value_, delta_>::operator=(const vectormap& other) {
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_> &vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::operator=(const vectormap& other) {
         if (this != &other) {
-            clear();
+            // Copied first, so that a failure cannot leave the elements and the index out of step.
+            index_type index = other.index_;
+            clear_();
+            if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+                if (allocator_ != other.allocator_) {
+                    // The current storage must be returned to the allocator that provided it.
+                    release_();
+                }
+                allocator_ = other.allocator_;
+            }
             if (other.size_ > capacity_) {
                 reserve(other.size_);
             }
-            
-            for (size_type i = 0; i < other.size_; ++i) {
-                allocator_traits::construct(allocator_, data_ + i, std::make_pair(other.data_[i].first, other.data_[i].second));
-            }
+
+            // If a copy throws, the vectormap is left empty.
+            construct_n_(data_, other.data_, other.size_);
+            size_ = other.size_;
+            stats_.grown(size_);
+            index_ = std::move(index);
         }
 
         return *this;
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    vectormap<key_, value_, delta_>& vectormap<key_, value_, delta_>::operator=(vectormap&& other) {
-        std::swap(other.allocator_, allocator_);
-        data_ = std::exchange(other.data_, nullptr);
-        size_ = std::exchange(other.size_, 0);
-        std::swap(other.capacity_, capacity_);
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>& vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::operator=(vectormap&& other) noexcept((allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value) &&
+                                                                                                                           ((inline_ == 0) || nothrow_relocatable_)) {
+        if (this != &other) {
+            clear_();
+            if (allocator_traits::propagate_on_container_move_assignment::value || (allocator_ == other.allocator_)) {
+                release_();
+                if constexpr (allocator_traits::propagate_on_container_move_assignment::value) {
+                    allocator_ = std::move(other.allocator_);
+                }
+                steal_(other);
+            }
+            else {
+                // The storage of other cannot be adopted: relocate its elements into memory of our allocator.
+                insert(std::move(other), 0);
+            }
+        }
 
         return *this;
     }
 
-    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_>
-    bool vectormap<key_, value_, delta_>::gap_(size_type from, size_type length)
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<std::invocable<const std::byte*, size_t> W>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::serialize(W&& writer) const requires serializable {
+        std::byte header[serialized_header::header_size] = {};
+        serialized_header fields = serialized_header::of<value_type>(size_);
+        std::memcpy(header, &fields, sizeof(fields));
+
+        writer(static_cast<const std::byte*>(header), sizeof(header));
+        writer(reinterpret_cast<const std::byte*>(data_), size_ * sizeof(value_type));
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    bool vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::deserialize(std::span<const std::byte> blob) requires serializable {
+        serialized_header header;
+        if (!serialized_header::read<value_type>(blob, header)) {
+            return false;
+        }
+
+        clear_();
+        if (header.count > capacity_) {
+            reserve(header.count);
+        }
+        if (header.count > 0) {
+            std::memcpy(static_cast<void*>(data_), blob.data() + serialized_header::header_size, header.count * sizeof(value_type));
+        }
+        size_ = header.count;
+        stats_.grown(size_);
+        index_.inserted(*this, 0, size_);
+        return true;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::release_() {
+        deallocate_(data_ - front_.get(), capacity_ + front_.get());
+        data_ = nullptr;
+        capacity_ = 0;
+        front_.set(0);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::shrink_if_sparse_() {
+        if constexpr (auto_shrink_) {
+            const size_type total = capacity_ + front_.get();
+            const size_type new_capacity = growth_type::shrink(total, size_, delta_);
+            if ((new_capacity >= total) || inline_buffer_.holds(data_)) {
+                return;
+            }
+            if ((size_ == 0) && (new_capacity == 0)) {
+                release_();
+                return;
+            }
+            try {
+                resize(new_capacity);
+            }
+            catch (...) {
+                // Shrinking only saves memory: the elements stay in the current buffer.
+            }
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::steal_(vectormap& other) {
+        if (other.inline_buffer_.holds(other.data_)) {
+            data_ = inline_buffer_.data();
+            capacity_ = inline_;
+            relocate_(data_, other.data_, other.size_);
+            size_ = std::exchange(other.size_, 0);
+        }
+        else {
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+            front_ = std::exchange(other.front_, {});
+        }
+        index_ = std::exchange(other.index_, index_type());
+        stats_.grown(size_);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::pointer vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::allocate_(size_type min_capacity, size_type& new_capacity) {
+        if constexpr (inline_ > 0) {
+            if ((min_capacity <= inline_) && !inline_buffer_.holds(data_)) {
+                new_capacity = inline_;
+                return inline_buffer_.data();
+            }
+        }
+
+        stats_.allocated(new_capacity * sizeof(value_type));
+        return allocator_traits::allocate(allocator_, new_capacity);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::deallocate_(pointer p, size_type capacity) {
+        if ((p != nullptr) && !inline_buffer_.holds(p)) {
+            allocator_traits::deallocate(allocator_, p, capacity);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class F>
+    bool vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::gap_(size_type from, size_type length, F&& construct)
     {
-        bool success = true;
+        if (from > size_) {
+            return false;
+        }
+
+        if constexpr (front_gap_enabled && nothrow_relocatable_) {
+            if (from < size_ - from) {
+                open_front_(length);
+                relocate_(data_ - length, data_, from);
+                try {
+                    construct(data_ - length + from);
+                }
+                catch (...) {
+                    relocate_(data_, data_ - length, from);
+                    throw;
+                }
+                data_ -= length;
+                capacity_ += length;
+                front_.set(front_.get() - length);
 
-        if ((size_ + length) > capacity_) {
-            success = reserve(size_ + length);
+                size_ = size_ + length;
+                stats_.grown(size_);
+                return true;
+            }
+        }
+
+        if (((size_ + length) > capacity_) || (!nothrow_relocatable_ && (from < size_))) {
+            // A relocation that throws halfway would leave destroyed elements behind: those elements are copied
+            // to a new buffer instead of being shifted in place.
+            size_type new_capacity = ((size_ + length) > capacity_) ? growth_type::grow(capacity_, size_ + length, delta_) : capacity_;
+            pointer new_data = allocate_(size_ + length, new_capacity);
+            try {
+                construct(new_data + from);
+            }
+            catch (...) {
+                deallocate_(new_data, new_capacity);
+                throw;
+            }
+            try {
+                adopt_(new_data, new_capacity, from, length);
+            }
+            catch (...) {
+                for (size_type i = 0; i < length; ++i) {
+                    allocator_traits::destroy(allocator_, new_data + from + i);
+                }
+                deallocate_(new_data, new_capacity);
+                throw;
+            }
+        }
+        else {
+            relocate_(data_ + from + length, data_ + from, size_ - from);
+            try {
+                construct(data_ + from);
+            }
+            catch (...) {
+                relocate_(data_ + from, data_ + from + length, size_ - from);
+                throw;
+            }
         }
 
         size_ = size_ + length;
-        if (size_ <= length) {
-            return true;
+        stats_.grown(size_);
+        return true;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::adopt_(pointer new_data, size_type new_capacity, size_type from, size_type length, size_type head) {
+        // Relocate both halves straight to their final place in the new buffer, after head free elements.
+        if constexpr (nothrow_relocatable_) {
+            relocate_(new_data + head, data_, from);
+            relocate_(new_data + head + from + length, data_ + from, size_ - from);
+        }
+        else {
+            // Both halves are built before anything is destroyed.
+            transfer_n_(new_data + head, data_, from);
+            try {
+                transfer_n_(new_data + head + from + length, data_ + from, size_ - from);
+            }
+            catch (...) {
+                for (size_type i = 0; i < from; ++i) {
+                    allocator_traits::destroy(allocator_, new_data + head + i);
+                }
+                throw;
+            }
+            for (size_type i = 0; i < size_; ++i) {
+                allocator_traits::destroy(allocator_, data_ + i);
+            }
+            stats_.relocated(size_);
         }
 
-        if (success) {
-            if (from >= size_){
-                return true;
+        release_();
+        data_ = new_data + head;
+        capacity_ = new_capacity - head;
+        front_.set(head);
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::open_front_(size_type length) {
+        // Makes room for length elements before the first one, leaving half of the remaining free room on each side.
+        if (front_.get() >= length) {
+            return;
+        }
+
+        const size_type total = front_.get() + capacity_;
+        if ((size_ + length) * 2 <= total) {
+            pointer base = data_ - front_.get();
+            const size_type head = length + (total - size_ - length) / 2;
+            relocate_(base + head, data_, size_);
+            data_ = base + head;
+            capacity_ = total - head;
+            front_.set(head);
+        }
+        else {
+            size_type new_capacity = growth_type::grow(total, size_ + length, delta_);
+            pointer new_data = allocate_(size_ + length, new_capacity);
+            try {
+                adopt_(new_data, new_capacity, size_, 0, length + (new_capacity - size_ - length) / 2);
+            }
+            catch (...) {
+                deallocate_(new_data, new_capacity);
+                throw;
+            }
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::relocate_(pointer dst, pointer src, size_type n) {
+        if ((n == 0) || (dst == src)) {
+            return;
+        }
+
+        stats_.relocated(n);
+        if constexpr (trivially_relocatable_) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(value_type));
+        }
+        else {
+            // The key is const only to the users; the element is destroyed right after being moved from.
+            auto relocate_one = [this](pointer to, pointer from) {
+                allocator_traits::construct(allocator_, to, std::move_if_noexcept(const_cast<key_type&>(from->first)), std::move_if_noexcept(from->second));
+                allocator_traits::destroy(allocator_, from);
+            };
+
+            if (dst < src) {
+                for (size_type i = 0; i < n; ++i) {
+                    relocate_one(dst + i, src + i);
+                }
             }
             else {
-                for (size_type i = size_ - 1; ((i > from) && ((i - length) != npos)); i--) {
-                    allocator_traits::construct(allocator_, data_ + i, std::move(data_[i - length]));
-                    allocator_traits::destroy(allocator_, data_ + i - length);
+                for (size_type i = n; i > 0; --i) {
+                    relocate_one(dst + i - 1, src + i - 1);
+                }
+            }
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class K>
+    typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::size_type vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::find_pos_(const K& key, size_type ordinal) const {
+        if constexpr (indexed_<K>) {
+            const std::vector<size_type>* positions = index_.positions(key);
+            size_type nth = ordinal > 0 ? ordinal - 1 : 0;
+            stats_.looked_up((positions != nullptr) && (nth < positions->size()) ? 1 : 0);
+            return (positions != nullptr) && (nth < positions->size()) ? (*positions)[nth] : npos;
+        }
+        else {
+            size_type out = npos;
+            size_type order = 1;
+
+            for_each_pos_(key, [&](size_type i) {
+                if (order++ >= ordinal) {
+                    out = i;
+                    return false;
                 }
                 return true;
+            });
+
+            return out;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class F>
+    typename vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::size_type vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::compact_(F&& remove) {
+        size_type kept = 0;
+        size_type run = 0;
+        [[maybe_unused]] std::vector<bool> removed;
+        if constexpr (compacts_) {
+            removed.assign(size_, false);
+        }
+        auto finish = [&]() {
+            size_type erased = std::exchange(size_, kept) - kept;
+            if (erased > 0) {
+                // The erased positions are scattered: rebuild the index in one pass instead of shifting it once per run.
+                if constexpr (compacts_) {
+                    index_.compacted(*this, removed);
+                }
+                else {
+                    index_.cleared();
+                    index_.inserted(*this, 0, size_);
+                }
+            }
+            return erased;
+        };
+
+        try {
+            for (size_type i = 0; i < size_; ) {
+                run = i;
+                while ((i < size_) && !remove(i)) {
+                    ++i;
+                }
+                relocate_(data_ + kept, data_ + run, i - run);
+                kept += i - run;
+                run = i;
+
+                if (i < size_) {
+                    allocator_traits::destroy(allocator_, data_ + i);
+                    if constexpr (compacts_) {
+                        removed[i] = true;
+                    }
+                    run = ++i;
+                }
+            }
+        }
+        catch (...) {
+            relocate_(data_ + kept, data_ + run, size_ - run);
+            kept += size_ - run;
+            finish();
+            throw;
+        }
+
+        size_type erased = finish();
+        shrink_if_sparse_();
+        return erased;
+    }
+
+template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class K, class F>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::for_each_pos_(const K& key, F&& f) const {
+        if constexpr (statistics_type::enabled) {
+            // A scan compares every element up to the one where f stopped it; an index visits only the matches.
+            size_type visited = 0;
+            size_type last = 0;
+            bool stopped = false;
+            scan_(key, [&](size_type i) {
+                ++visited;
+                last = i;
+                stopped = !f(i);
+                return !stopped;
+            });
+            stats_.looked_up(indexed_<K> || ordered_<K> ? visited : (stopped ? last + 1 : size_));
+        }
+        else {
+            scan_(key, f);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class K, class F>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::for_each_pos_from_(const K& key, size_type ordinal, F&& f) const {
+        if constexpr (indexed_<K>) {
+            // The positions of key are sorted: the ordinal-th occurrence is right there.
+            const std::vector<size_type>* positions = index_.positions(key);
+            size_type visited = 0;
+            if (positions != nullptr) {
+                for (size_type i = ordinal > 0 ? ordinal - 1 : 0; i < positions->size(); ++i) {
+                    ++visited;
+                    if (!f((*positions)[i])) {
+                        break;
+                    }
+                }
             }
+            stats_.looked_up(visited);
         }
         else {
-            return false;
+            size_type order = 1;
+            for_each_pos_(key, [&](size_type i) { return order++ < ordinal || f(i); });
         }
     }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class K, class F>
+    void vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::scan_(const K& key, F&& f) const {
+        if constexpr (indexed_<K>) {
+            const std::vector<size_type>* positions = index_.positions(key);
+            if (positions != nullptr) {
+                for (size_type i : *positions) {
+                    if (!f(i)) {
+                        return;
+                    }
+                }
+            }
+        }
+        else if constexpr (ordered_<K>) {
+            for (size_type i : index_.equal_range(*this, key)) {
+                if (!f(i)) {
+                    return;
+                }
+            }
+        }
+        else {
+            scan_range_(key, 0, size_, f);
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_, class indexing_, class growth_, class alloc_, size_t inline_, class statistics_>
+    template<class K, class F>
+    bool vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_, statistics_>::scan_range_(const K& key, size_type first, size_type last, F&& f) const {
+        if constexpr (std::same_as<K, key_type> && simd::Scannable<key_type> && std::is_standard_layout_v<value_type>) {
+            // The key is the first member of the pair: scan the keys with a stride of one element.
+            return simd::for_each_match<key_type, sizeof(value_type)>(reinterpret_cast<const std::byte*>(data_ + first), last - first, key,
+                                                                      [&](size_type i) { return f(first + i); });
+        }
+        else if constexpr (filtered_<K>) {
+            return index_.for_each_candidate(key, first, last, [&](size_type i) { return !(data_[i].first == key) || f(i); });
+        }
+        else {
+            for (size_type i = first; i < last; ++i) {
+                if ((data_[i].first == key) && !f(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    /**
+     * @brief vectormap with amortized constant time insertions and erasures at both ends (see front_gap).
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100, class indexing_ = no_index>
+    using deque_vectormap = vectormap<key_, value_, delta_, indexing_, front_gap<geometric_growth<2>>>;
+
+    /**
+     * @brief vectormap that counts the work it does, exposed by stats().
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100, class indexing_ = no_index, class growth_ = delta_growth>
+    using instrumented_vectormap = vectormap<key_, value_, delta_, indexing_, growth_, std::allocator<std::pair<const key_, value_>>, 0, counting_stats>;
+
+    /**
+     * @brief vectormap that stores up to inline_ elements inside the object, and only uses the allocator past that.\n
+     *        Moving or swapping it relocates the inline elements instead of exchanging the storage.
+     *
+     * @tparam inline_ Number of elements stored inside the object.
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t inline_, size_t delta_ = 100, class indexing_ = no_index, class growth_ = delta_growth,
+             class alloc_ = std::allocator<std::pair<const key_, value_>>>
+    using small_vectormap = vectormap<key_, value_, delta_, indexing_, growth_, alloc_, inline_>;
+
+    namespace pmr {
+        /**
+         * @brief vectormap whose elements are allocated from a std::pmr::memory_resource,
+         *        e.g. a std::pmr::monotonic_buffer_resource arena released in one shot.
+         */
+        template<DefaultInitializableKeyable key_, std::default_initializable value_, size_t delta_ = 100, class indexing_ = no_index, class growth_ = delta_growth>
+        using vectormap = com::vectormap<key_, value_, delta_, indexing_, growth_, std::pmr::polymorphic_allocator<std::pair<const key_, value_>>>;
+    }
 }
 #endif
@@ -0,0 +1,135 @@
+#ifndef __VECTORMAPPARALLEL_H__
+#define __VECTORMAPPARALLEL_H__
+
+#include "vectormap.hpp"
+
+#include <algorithm>
+#include <execution>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Execution policy overloads of the vectormap bulk operations.\n
+ *        They are kept out of vectormap.hpp because with some standard libraries (libstdc++ with TBB installed)
+ *        including <execution> requires linking the parallel backend.
+ */
+namespace com {
+    template<class T>
+    concept ExecutionPolicy = std::is_execution_policy_v<std::remove_cvref_t<T>>;
+
+    /** @cond */
+    template<class map_>
+    concept ParallelVectormap = requires { typename map_::index_type; typename map_::iterator_pos; };
+
+    namespace detail {
+        // Elements scanned by each task; smaller vectormaps are scanned sequentially.
+        inline constexpr size_t parallel_chunk = 16384;
+    }
+    /** @endcond */
+
+    /**
+     * @brief Positions of every element with a given key, scanning chunks of the vectormap with an execution policy.\n
+     *        The positions of every chunk are merged in ascending order, as get_all_pos(key) returns them.
+     *        Small vectormaps, and vectormaps with an index, are looked up sequentially.
+     *
+     * @param policy  Execution policy of the scan, e.g. std::execution::par.
+     * @param map     vectormap to look up.
+     * @param key     Key to look for.
+     * @return std::vector<size_type>  Ascending positions of the key.
+     */
+    template<ExecutionPolicy E, ParallelVectormap map_>
+    std::vector<typename map_::size_type> get_all_pos(E&& policy, const map_& map, const typename map_::key_type& key) {
+        using size_type = typename map_::size_type;
+        const size_type size = map.size();
+        if (map_::index_type::enabled || (size < 2 * detail::parallel_chunk)) {
+            return map.get_all_pos(key);
+        }
+
+        std::vector<std::vector<size_type>> found((size + detail::parallel_chunk - 1) / detail::parallel_chunk);
+        std::vector<size_type> chunks(found.size());
+        for (size_type c = 0; c < chunks.size(); ++c) {
+            chunks[c] = c;
+        }
+
+        std::for_each(std::forward<E>(policy), chunks.begin(), chunks.end(), [&](size_type c) {
+            map.for_each_pos(key, c * detail::parallel_chunk, std::min(size, (c + 1) * detail::parallel_chunk), [&](size_type i) {
+                found[c].push_back(i);
+                return true;
+            });
+        });
+
+        size_type total = 0;
+        for (const std::vector<size_type>& positions : found) {
+            total += positions.size();
+        }
+
+        std::vector<size_type> out;
+        out.reserve(total);
+        for (const std::vector<size_type>& positions : found) {
+            out.insert(out.end(), positions.begin(), positions.end());
+        }
+
+        return out;
+    }
+
+    /**
+     * @brief Every element with a given key, in insertion order, scanning chunks of the vectormap with an execution policy.
+     */
+    template<ExecutionPolicy E, ParallelVectormap map_>
+    std::vector<typename map_::iterator_pos> get_all(E&& policy, map_& map, const typename map_::key_type& key) {
+        std::vector<typename map_::iterator_pos> out;
+        for (typename map_::size_type i : get_all_pos(std::forward<E>(policy), std::as_const(map), key)) {
+            out.push_back(std::make_pair(map.get_at(i), i));
+        }
+
+        return out;
+    }
+
+    /**
+     * @brief Values of every element with a given key, in insertion order, scanning chunks of the vectormap with an execution policy.
+     */
+    template<ExecutionPolicy E, ParallelVectormap map_>
+    std::vector<typename map_::mapped_type> get_all_values(E&& policy, const map_& map, const typename map_::key_type& key) {
+        std::vector<typename map_::mapped_type> out;
+        for (typename map_::size_type i : get_all_pos(std::forward<E>(policy), map, key)) {
+            out.push_back(map[i].second);
+        }
+
+        return out;
+    }
+
+    /**
+     * @brief Erases every element for which pred returns true, evaluating pred with an execution policy.\n
+     *        pred may be called concurrently and in any order; the kept elements are then compacted
+     *        in a single sequential pass, keeping their order.
+     *
+     * @param policy       Execution policy of the predicate calls.
+     * @param map          vectormap to modify.
+     * @param pred         Predicate called once per element with a const reference to it.
+     * @return size_type   Number of erased elements.
+     */
+    template<ExecutionPolicy E, ParallelVectormap map_, class P>
+    typename map_::size_type erase_if(E&& policy, map_& map, P pred) {
+        std::vector<unsigned char> remove(map.size());
+        std::transform(std::forward<E>(policy), map.data(), map.data() + map.size(), remove.begin(), [&pred](const typename map_::value_type& elem) -> unsigned char {
+            return static_cast<bool>(pred(elem));
+        });
+
+        size_t i = 0;
+        return map.erase_if([&](const typename map_::value_type&) { return remove[i++] != 0; });
+    }
+
+    /**
+     * @brief Calls fn with a reference to the value of every element, with an execution policy.\n
+     *        fn may be called concurrently and in any order. The keys are not modified, so the index stays valid.
+     *
+     * @param policy  Execution policy of the calls.
+     * @param map     vectormap to modify.
+     * @param fn      Function called with (mapped_type&).
+     */
+    template<ExecutionPolicy E, ParallelVectormap map_, class F>
+    void for_each_value(E&& policy, map_& map, F fn) {
+        std::for_each(std::forward<E>(policy), map.data(), map.data() + map.size(), [&fn](typename map_::value_type& elem) { fn(elem.second); });
+    }
+}
+#endif
@@ -0,0 +1,235 @@
+#ifndef __VECTORMAPSIMD_H__
+#define __VECTORMAPSIMD_H__
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(VECTORMAP_NO_SIMD)
+#elif defined(__AVX2__)
+#define VECTORMAP_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define VECTORMAP_SIMD_SSE2
+#elif defined(__ARM_NEON)
+#define VECTORMAP_SIMD_NEON
+#endif
+
+#if defined(VECTORMAP_SIMD_AVX2) || defined(VECTORMAP_SIMD_SSE2)
+#include <immintrin.h>
+#elif defined(VECTORMAP_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief Vectorized key scans.\n
+ *        The instruction set is selected at compile time (AVX2, SSE2 or NEON), with a scalar fallback.
+ *        Defining VECTORMAP_NO_SIMD forces the scalar fallback.
+ */
+namespace com::simd {
+    /**
+     * @brief Keys that can be compared byte by byte: integral and enumeration types of 1, 2, 4 or 8 bytes.
+     */
+    template<class T>
+    concept Scannable = (std::is_integral_v<T> || std::is_enum_v<T>) &&
+                        ((sizeof(T) == 1) || (sizeof(T) == 2) || (sizeof(T) == 4) || (sizeof(T) == 8));
+
+    /** @cond */
+    namespace detail {
+        template<size_t size_> struct uint_of;
+        template<> struct uint_of<1> { using type = uint8_t; };
+        template<> struct uint_of<2> { using type = uint16_t; };
+        template<> struct uint_of<4> { using type = uint32_t; };
+        template<> struct uint_of<8> { using type = uint64_t; };
+
+        template<class T>
+        typename uint_of<sizeof(T)>::type bits(const void* p) {
+            typename uint_of<sizeof(T)>::type out;
+            std::memcpy(&out, p, sizeof(T));
+            return out;
+        }
+
+#if defined(VECTORMAP_SIMD_AVX2)
+        // movemask gives one bit per byte of a 32 byte register.
+        struct isa {
+            static constexpr size_t width = 32;
+            static constexpr size_t bits_per_byte = 1;
+            using reg = __m256i;
+
+            template<size_t size_>
+            static reg broadcast(typename uint_of<size_>::type key) {
+                if constexpr (size_ == 1) return _mm256_set1_epi8(static_cast<char>(key));
+                else if constexpr (size_ == 2) return _mm256_set1_epi16(static_cast<short>(key));
+                else if constexpr (size_ == 4) return _mm256_set1_epi32(static_cast<int>(key));
+                else return _mm256_set1_epi64x(static_cast<long long>(key));
+            }
+
+            template<size_t size_>
+            static uint64_t match(const std::byte* p, reg key) {
+                reg block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                reg eq;
+                if constexpr (size_ == 1) eq = _mm256_cmpeq_epi8(block, key);
+                else if constexpr (size_ == 2) eq = _mm256_cmpeq_epi16(block, key);
+                else if constexpr (size_ == 4) eq = _mm256_cmpeq_epi32(block, key);
+                else eq = _mm256_cmpeq_epi64(block, key);
+                return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+            }
+        };
+#elif defined(VECTORMAP_SIMD_SSE2)
+        // movemask gives one bit per byte of a 16 byte register.
+        struct isa {
+            static constexpr size_t width = 16;
+            static constexpr size_t bits_per_byte = 1;
+            using reg = __m128i;
+
+            template<size_t size_>
+            static reg broadcast(typename uint_of<size_>::type key) {
+                if constexpr (size_ == 1) return _mm_set1_epi8(static_cast<char>(key));
+                else if constexpr (size_ == 2) return _mm_set1_epi16(static_cast<short>(key));
+                else if constexpr (size_ == 4) return _mm_set1_epi32(static_cast<int>(key));
+                else return _mm_set1_epi64x(static_cast<long long>(key));
+            }
+
+            template<size_t size_>
+            static uint64_t match(const std::byte* p, reg key) {
+                reg block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                reg eq;
+                if constexpr (size_ == 1) eq = _mm_cmpeq_epi8(block, key);
+                else if constexpr (size_ == 2) eq = _mm_cmpeq_epi16(block, key);
+                else if constexpr (size_ == 4) eq = _mm_cmpeq_epi32(block, key);
+                else {
+#if defined(__SSE4_1__)
+                    eq = _mm_cmpeq_epi64(block, key);
+#else
+                    // Both 32 bit halves must be equal.
+                    eq = _mm_cmpeq_epi32(block, key);
+                    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+#endif
+                }
+                return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+            }
+        };
+#elif defined(VECTORMAP_SIMD_NEON)
+        // There is no movemask: narrowing the comparison gives four bits per byte.
+        struct isa {
+            static constexpr size_t width = 16;
+            static constexpr size_t bits_per_byte = 4;
+            using reg = uint8x16_t;
+
+            template<size_t size_>
+            static reg broadcast(typename uint_of<size_>::type key) {
+                if constexpr (size_ == 1) return vdupq_n_u8(key);
+                else if constexpr (size_ == 2) return vreinterpretq_u8_u16(vdupq_n_u16(key));
+                else if constexpr (size_ == 4) return vreinterpretq_u8_u32(vdupq_n_u32(key));
+                else return vreinterpretq_u8_u64(vdupq_n_u64(key));
+            }
+
+            template<size_t size_>
+            static uint64_t match(const std::byte* p, reg key) {
+                reg block = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+                reg eq;
+                if constexpr (size_ == 1) eq = vceqq_u8(block, key);
+                else if constexpr (size_ == 2) eq = vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(block), vreinterpretq_u16_u8(key)));
+                else if constexpr (size_ == 4) eq = vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(block), vreinterpretq_u32_u8(key)));
+                else eq = vreinterpretq_u8_u64(vceqq_u64(vreinterpretq_u64_u8(block), vreinterpretq_u64_u8(key)));
+                uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+                return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+            }
+        };
+#else
+        // Scalar fallback, only declared so that the vectorized path compiles away.
+        struct isa {
+            static constexpr size_t width = 0;
+            static constexpr size_t bits_per_byte = 1;
+            using reg = uint64_t;
+
+            template<size_t size_>
+            static reg broadcast(typename uint_of<size_>::type key);
+
+            template<size_t size_>
+            static uint64_t match(const std::byte* p, reg key);
+        };
+#endif
+
+        // One bit for the first byte of every key in a register.
+        template<size_t stride_>
+        constexpr uint64_t key_pattern() {
+            uint64_t out = 0;
+            for (size_t offset = 0; offset < isa::width; offset += stride_) {
+                out |= uint64_t(1) << (offset * isa::bits_per_byte);
+            }
+            return out;
+        }
+    }
+    /** @endcond */
+
+    /**
+     * @brief Tells whether for_each_match can compare several keys per instruction for a layout.
+     *
+     * @tparam K       Type of the key.
+     * @tparam stride_ Distance in bytes between two consecutive keys.
+     */
+    template<class K, size_t stride_>
+    inline constexpr bool vectorized = Scannable<K> && (detail::isa::width != 0) &&
+                                       (2 * stride_ <= detail::isa::width) && (detail::isa::width % stride_ == 0) && (stride_ % sizeof(K) == 0);
+
+    /**
+     * @brief Calls f(i) for every i in [0, n) whose key equals key, in ascending order, until f returns false.\n
+     *        The i-th key is stored at base + i * stride_.
+     *
+     * @tparam K       Type of the key.
+     * @tparam stride_ Distance in bytes between two consecutive keys.
+     * @param base     Address of the first key.
+     * @param n        Number of keys.
+     * @param key      Key to look for.
+     * @param f        Function called with the index of every match.
+     * @return bool    false if f stopped the scan.
+     */
+    template<Scannable K, size_t stride_, class F>
+    bool for_each_match(const std::byte* base, size_t n, const K& key, F&& f) {
+        using uint_type = typename detail::uint_of<sizeof(K)>::type;
+        const uint_type bits = detail::bits<K>(&key);
+        size_t i = 0;
+
+        if constexpr (vectorized<K, stride_>) {
+            constexpr size_t per_block = detail::isa::width / stride_;
+            constexpr uint64_t pattern = detail::key_pattern<stride_>();
+            const auto broadcast = detail::isa::template broadcast<sizeof(K)>(bits);
+
+            for (; i + per_block <= n; i += per_block) {
+                uint64_t mask = detail::isa::template match<sizeof(K)>(base + i * stride_, broadcast) & pattern;
+                while (mask != 0) {
+                    if (!f(i + static_cast<size_t>(std::countr_zero(mask)) / (stride_ * detail::isa::bits_per_byte))) {
+                        return false;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+        }
+
+        for (; i < n; ++i) {
+            if ((detail::bits<K>(base + i * stride_) == bits) && !f(i)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Calls f(i) for every i in [0, n) such that keys[i] == key, in ascending order, until f returns false.
+     *
+     * @param keys   Contiguous array of keys.
+     * @param n      Number of keys.
+     * @param key    Key to look for.
+     * @param f      Function called with the index of every match.
+     * @return bool  false if f stopped the scan.
+     */
+    template<Scannable K, class F>
+    bool for_each_match(const K* keys, size_t n, const K& key, F&& f) {
+        return for_each_match<K, sizeof(K)>(reinterpret_cast<const std::byte*>(keys), n, key, std::forward<F>(f));
+    }
+}
+#endif
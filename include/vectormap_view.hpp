@@ -0,0 +1,246 @@
+#ifndef __VECTORMAPVIEW_H__
+#define __VECTORMAPVIEW_H__
+
+#include "vectormap.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace com {
+    /**
+     * @brief Read-only vectormap over a blob written by vectormap::serialize, e.g. a memory-mapped file.\n
+     *        The elements are used in place: building the view only checks the header.
+     *        The blob must outlive the view and stay unchanged while it is in use.
+     *
+     * @tparam key_   Type of the key.
+     * @tparam value_ Type of the value.
+     */
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    class vectormap_view
+    {
+        public:
+            /** @cond */
+            using key_type = key_;
+            using mapped_type = value_;
+            using value_type = std::pair<const key_type, mapped_type>;
+            using const_reference = const value_type&;
+            using const_pointer = const value_type*;
+            using const_iterator = const_pointer;
+            using iterator = const_iterator;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+            using size_type = size_t;
+            using iterator_pos = std::pair<const_iterator, size_type>;
+
+            static constexpr size_type npos = std::numeric_limits<size_type>::max();
+            static constexpr bool positional_overloads = !(std::is_convertible_v<key_type, size_type> && std::is_convertible_v<size_type, key_type>);
+            /** @endcond */
+
+            static_assert(is_bitwise_serializable<key_type>::value && is_bitwise_serializable<mapped_type>::value,
+                          "vectormap_view needs bitwise serializable keys and values");
+
+            /** @name Constructors */
+            /** @{ */
+            /**
+             * @brief Empty view.
+             */
+            vectormap_view() = default;
+
+            /**
+             * @brief View over a serialized vectormap.\n
+             *        If the blob is not valid for this key and value, the view is empty and is_valid() is false.
+             *
+             * @param blob Bytes written by vectormap::serialize, aligned as value_type.
+             */
+            explicit vectormap_view(std::span<const std::byte> blob);
+            /** @} */
+
+            /** @name Element access */
+            /** @{ */
+            const_iterator get(const size_type pos) const requires positional_overloads { return get_at(pos); }
+            std::vector<iterator_pos> get(const key_type& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<iterator_pos> get_all(const key_type& key) const;
+            const mapped_type& get_value(const size_type pos) const requires positional_overloads { return get_value_at(pos); }
+            std::vector<mapped_type> get_value(const key_type& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<mapped_type> get_all_values(const key_type& key) const;
+            const key_type& get_key(const size_type pos) const { return get_key_at(pos); }
+            std::vector<size_type> get_pos(const key_type& key, size_type ordinal = 1, size_type number = 1) const;
+            std::vector<size_type> get_all_pos(const key_type& key) const;
+            const_iterator get_at(const size_type pos) const { return pos < size_ ? data_ + pos : end(); }
+            const mapped_type& get_value_at(const size_type pos) const { return pos < size_ ? data_[pos].second : void_mapped_type_; }
+            const key_type& get_key_at(const size_type pos) const { return pos < size_ ? data_[pos].first : void_key_type_; }
+            const_reference operator[](const size_type pos) const { return data_[pos]; }
+            const_iterator find(const key_type& key) const { return find_nth(key, 1); }
+            const_iterator find_nth(const key_type& key, size_type ordinal) const;
+            size_type count(const key_type& key) const;
+            bool contains(const key_type& key) const { return find(key) != end(); }
+            const_pointer data() const { return data_; }
+            /** @} */
+
+            /** @name  Memory manipulation */
+            /** @{ */
+            size_type size() const { return size_; }
+            bool is_empty() const { return size_ == 0; }
+            /**
+             * @brief Tells whether the view was built over a valid blob.
+             */
+            bool is_valid() const { return valid_; }
+            /** @} */
+
+            /** @name  Iterators */
+            /** @{ */
+            const_iterator begin() const { return data_; }
+            const_iterator end() const { return data_ + size_; }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+            const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+            const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+            const_reverse_iterator crbegin() const { return rbegin(); }
+            const_reverse_iterator crend() const { return rend(); }
+            /** @} */
+
+        private:
+            const_pointer data_ = nullptr;
+            size_type size_ = 0;
+            bool valid_ = false;
+            static inline const mapped_type void_mapped_type_{};
+            static inline const key_type void_key_type_{};
+
+            template<class F>
+            void for_each_pos_(const key_type& key, F&& f) const;
+    };
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    vectormap_view<key_, value_>::vectormap_view(std::span<const std::byte> blob) {
+        serialized_header header;
+        if (serialized_header::read<value_type>(blob, header)) {
+            data_ = reinterpret_cast<const_pointer>(blob.data() + serialized_header::header_size);
+            size_ = header.count;
+            valid_ = true;
+        }
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    std::vector<typename vectormap_view<key_, value_>::iterator_pos> vectormap_view<key_, value_>::get(const key_type& key, size_type ordinal, size_type number) const {
+        std::vector<iterator_pos> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order >= ordinal) {
+                out.push_back(std::make_pair(data_ + i, i));
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    std::vector<typename vectormap_view<key_, value_>::iterator_pos> vectormap_view<key_, value_>::get_all(const key_type& key) const {
+        std::vector<iterator_pos> out;
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(std::make_pair(data_ + i, i));
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    std::vector<typename vectormap_view<key_, value_>::mapped_type> vectormap_view<key_, value_>::get_value(const key_type& key, size_type ordinal, size_type number) const {
+        std::vector<mapped_type> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order >= ordinal) {
+                out.push_back(data_[i].second);
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    std::vector<typename vectormap_view<key_, value_>::mapped_type> vectormap_view<key_, value_>::get_all_values(const key_type& key) const {
+        std::vector<mapped_type> out;
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(data_[i].second);
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    std::vector<typename vectormap_view<key_, value_>::size_type> vectormap_view<key_, value_>::get_pos(const key_type& key, size_type ordinal, size_type number) const {
+        std::vector<size_type> out;
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order >= ordinal) {
+                out.push_back(i);
+            }
+            ++order;
+            return out.size() < number;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    std::vector<typename vectormap_view<key_, value_>::size_type> vectormap_view<key_, value_>::get_all_pos(const key_type& key) const {
+        std::vector<size_type> out;
+        for_each_pos_(key, [&](size_type i) {
+            out.push_back(i);
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    typename vectormap_view<key_, value_>::const_iterator vectormap_view<key_, value_>::find_nth(const key_type& key, size_type ordinal) const {
+        const_iterator out = end();
+        size_type order = 1;
+
+        for_each_pos_(key, [&](size_type i) {
+            if (order++ >= ordinal) {
+                out = data_ + i;
+                return false;
+            }
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    typename vectormap_view<key_, value_>::size_type vectormap_view<key_, value_>::count(const key_type& key) const {
+        size_type out = 0;
+        for_each_pos_(key, [&](size_type) {
+            ++out;
+            return true;
+        });
+
+        return out;
+    }
+
+    template<DefaultInitializableKeyable key_, std::default_initializable value_>
+    template<class F>
+    void vectormap_view<key_, value_>::for_each_pos_(const key_type& key, F&& f) const {
+        if constexpr (simd::Scannable<key_type> && std::is_standard_layout_v<value_type>) {
+            simd::for_each_match<key_type, sizeof(value_type)>(reinterpret_cast<const std::byte*>(data_), size_, key, f);
+        }
+        else {
+            for (size_type i = 0; i < size_; ++i) {
+                if ((data_[i].first == key) && !f(i)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+#endif
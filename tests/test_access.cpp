@@ -1,7 +1,14 @@
 #include "vectormap.hpp"
+#include "vectormap_parallel.hpp"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <execution>
 #include <iostream>
+#include <ranges>
+#include <span>
+#include <string_view>
 
 using vmap = com::vectormap<std::string, size_t, 3>;
 
@@ -145,3 +152,159 @@ TEST_F(VectorMapTestAccess, GetAllPos) {
     EXPECT_EQ(v.at(1), 4);
     EXPECT_EQ(v.at(2), 7);
 }
+
+TEST_F(VectorMapTestAccess, Find) {
+    vmap::iterator it = n.find("Dos");
+
+    ASSERT_NE(it, n.end());
+    EXPECT_EQ(it->second, 2);
+    EXPECT_EQ(n.find("Nueve"), n.end());
+
+    const vmap& c = n;
+    EXPECT_EQ(c.find("Seis")->second, 6);
+}
+
+TEST_F(VectorMapTestAccess, FindNth) {
+    EXPECT_EQ(n.find_nth("Dos", 1)->second, 2);
+    EXPECT_EQ(n.find_nth("Dos", 3)->second, 7);
+    EXPECT_EQ(n.find_nth("Dos", 4), n.end());
+}
+
+TEST_F(VectorMapTestAccess, FindNextPos) {
+    std::vector<vmap::size_type> v;
+    for (vmap::size_type pos = n.find_next_pos("Dos", 0); pos != vmap::npos; pos = n.find_next_pos("Dos", pos + 1)) {
+        v.push_back(pos);
+    }
+    EXPECT_EQ(v, n.get_all_pos("Dos"));
+    EXPECT_EQ(n.find_next_pos("Dos", 4), 4);
+    EXPECT_EQ(n.find_next_pos("Cero", 1), vmap::npos);
+    EXPECT_EQ(n.find_next_pos("Ocho", 9), vmap::npos);
+    EXPECT_EQ(n.find_next_pos(std::string_view("Seis"), 0), 6);
+}
+
+TEST_F(VectorMapTestAccess, CountContains) {
+    EXPECT_EQ(n.count("Dos"), 3);
+    EXPECT_EQ(n.count("Uno"), 1);
+    EXPECT_EQ(n.count("Nueve"), 0);
+    EXPECT_TRUE(n.contains("Ocho"));
+    EXPECT_FALSE(n.contains("Nueve"));
+}
+
+TEST_F(VectorMapTestAccess, EqualRangeView) {
+    std::vector<vmap::mapped_type> v;
+    for (auto& elem : n.equal_range_view("Dos")) {
+        EXPECT_EQ(elem.first, "Dos");
+        v.push_back(elem.second);
+    }
+
+    EXPECT_EQ(v, std::vector<vmap::mapped_type>({2, 4, 7}));
+    EXPECT_EQ(std::ranges::distance(n.equal_range_view("Nueve")), 0);
+
+    for (auto& elem : n.equal_range_view("Dos")) {
+        elem.second *= 10;
+    }
+    EXPECT_EQ(n.get_all_values("Dos"), std::vector<vmap::mapped_type>({20, 40, 70}));
+}
+
+TEST_F(VectorMapTestAccess, ParallelGetAll) {
+    EXPECT_EQ(com::get_all_pos(std::execution::par, n, "Dos"), std::vector<vmap::size_type>({2, 4, 7}));
+
+    com::vectormap<uint64_t, uint64_t> p;
+    for (uint64_t i = 0; i < 100000; ++i) {
+        p.push_back(i % 1000, i);
+    }
+
+    std::vector<size_t> pos = com::get_all_pos(std::execution::par, p, 7);
+    EXPECT_EQ(pos, p.get_all_pos(7));
+    EXPECT_EQ(pos.size(), 100);
+    EXPECT_EQ(com::get_all_values(std::execution::par_unseq, p, 999), p.get_all_values(999));
+    EXPECT_EQ(com::get_all(std::execution::seq, p, 3).at(50).first->second, 50003);
+
+    com::vectormap<std::string, uint64_t> q;
+    for (uint64_t i = 0; i < 40000; ++i) {
+        q.push_back(std::to_string(i % 7), i);
+    }
+    EXPECT_EQ(com::get_all_pos(std::execution::par, q, "3"), q.get_all_pos("3"));
+}
+
+TEST_F(VectorMapTestAccess, ForEachValue) {
+    n.for_each_value([](size_t& value) { value += 1; });
+    EXPECT_EQ(n.get_all_values("Dos"), std::vector<vmap::mapped_type>({3, 5, 8}));
+
+    com::for_each_value(std::execution::par, n, [](size_t& value) { value *= 2; });
+    EXPECT_EQ(n.get_all_values("Dos"), std::vector<vmap::mapped_type>({6, 10, 16}));
+    EXPECT_EQ(n.get_value("Cero").at(0), 2);
+}
+
+TEST_F(VectorMapTestAccess, RandomAccessIterators) {
+    static_assert(std::contiguous_iterator<vmap::iterator>);
+    static_assert(std::contiguous_iterator<vmap::const_iterator>);
+    static_assert(std::ranges::contiguous_range<vmap>);
+    static_assert(std::ranges::contiguous_range<const vmap>);
+
+    vmap::iterator it = n.begin() + 2;
+    EXPECT_EQ(it->first, "Dos");
+    EXPECT_EQ((3 + it)->second, 5);
+    EXPECT_EQ(it[1].first, "Tres");
+    it += 4;
+    EXPECT_EQ(it->second, 6);
+    it -= 6;
+    EXPECT_EQ(it, n.begin());
+    EXPECT_EQ(n.end() - n.begin(), 9);
+    EXPECT_LT(n.begin(), n.end());
+    EXPECT_EQ(std::to_address(n.begin() + 3), n.data() + 3);
+
+    vmap::const_iterator cit = n.begin() + 1;
+    EXPECT_EQ(cit, n.begin() + 1);
+    EXPECT_GT(n.cend(), cit);
+    EXPECT_EQ(n.cend() - cit, 8);
+
+    const vmap& c = n;
+    EXPECT_EQ(c.rbegin()->first, "Ocho");
+    EXPECT_EQ((c.rend() - 1)->first, "Cero");
+    EXPECT_EQ(c.crbegin(), c.rbegin());
+    EXPECT_EQ(c.crend() - c.crbegin(), 9);
+
+    std::span<const vmap::value_type> s(c.begin(), c.end());
+    EXPECT_EQ(s.size(), 9);
+    EXPECT_EQ(s[4].second, 4);
+
+    com::vectormap<size_t, size_t> p;
+    for (size_t i = 0; i < 100; ++i) {
+        p.push_back(i * 2, i);
+    }
+    auto lb = std::lower_bound(p.begin(), p.end(), 51, [](const auto& elem, size_t key) { return elem.first < key; });
+    EXPECT_EQ(lb - p.begin(), 26);
+    EXPECT_EQ(std::ranges::distance(p | std::views::drop(10) | std::views::take(5)), 5);
+    std::for_each(std::execution::par, p.begin(), p.end(), [](auto& elem) { elem.second += 1; });
+    EXPECT_EQ(p.get_value_at(99), 100);
+}
+
+namespace {
+    // Comparable with std::string but not convertible to it: only a transparent lookup compiles.
+    struct name {
+        std::string_view text;
+        friend bool operator==(const std::string& key, const name& n) { return key == n.text; }
+    };
+}
+
+TEST_F(VectorMapTestAccess, TransparentLookup) {
+    const std::string_view dos = "Dos";
+    EXPECT_EQ(n.get_all_pos(dos), std::vector<size_t>({2, 4, 7}));
+    EXPECT_EQ(n.get_value(dos, 2).at(0), 4);
+    EXPECT_EQ(n.count(name{"Dos"}), 3);
+    EXPECT_EQ(n.find(name{"Cinco"})->second, 5);
+    EXPECT_EQ(n.find_nth(name{"Dos"}, 3)->second, 7);
+    EXPECT_FALSE(n.contains(name{"Nueve"}));
+    EXPECT_EQ(std::ranges::distance(n.equal_range_view(name{"Dos"})), 3);
+
+    n.set_value(20, name{"Dos"}, 2);
+    n.set_key("Veinte", name{"Dos"}, 2);
+    EXPECT_EQ(n.get_key_at(4), "Veinte");
+    EXPECT_EQ(n.get_value_at(4), 20);
+
+    n.erase(name{"Cero"});
+    EXPECT_EQ(n.erase_all(name{"Dos"}), 2);
+    EXPECT_EQ(n.size(), 6);
+    EXPECT_EQ(n.get_key_at(0), "Uno");
+}
@@ -0,0 +1,214 @@
+#include "chunked_vectormap.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using vmap = com::vectormap<std::string, size_t, 3>;
+using cmap = com::chunked_vectormap<std::string, size_t, 2>;
+
+// Counts its copies, so that the tests can check that an element is moved instead.
+struct copy_counted {
+    static inline size_t copies = 0;
+    size_t value = 0;
+
+    copy_counted() = default;
+    copy_counted(size_t v) : value(v) {}
+    copy_counted(const copy_counted& other) : value(other.value) { ++copies; }
+    copy_counted(copy_counted&&) noexcept = default;
+    copy_counted& operator=(const copy_counted& other) { value = other.value; ++copies; return *this; }
+    copy_counted& operator=(copy_counted&&) noexcept = default;
+};
+
+class VectorMapTestChunked : public ::testing::Test {
+    protected:
+        vmap n = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+        cmap m = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+
+        void expect_same_elements() {
+            ASSERT_EQ(m.size(), n.size());
+            size_t i = 0;
+            for (const auto& elem : m) {
+                EXPECT_EQ(elem, n[i]);
+                EXPECT_EQ(m[i], n[i]);
+                EXPECT_EQ(m.get_key(i), n.get_key(i));
+                ++i;
+            }
+            EXPECT_EQ(i, n.size());
+        }
+};
+
+TEST_F(VectorMapTestChunked, Access) {
+    EXPECT_GT(m.chunks(), 1);
+    expect_same_elements();
+
+    EXPECT_EQ(m.get_all_pos("Dos"), n.get_all_pos("Dos"));
+    EXPECT_EQ(m.get_pos("Dos", 2, 5), std::vector<size_t>({4, 7}));
+    EXPECT_EQ(m.get_all_values("Dos"), std::vector<size_t>({2, 4, 7}));
+    EXPECT_EQ(m.get_value("Dos", 3).at(0), 7);
+    EXPECT_EQ(m.count("Dos"), 3);
+    EXPECT_TRUE(m.contains("Ocho"));
+    EXPECT_FALSE(m.contains("Nueve"));
+    EXPECT_EQ(m.find("Nueve"), m.end());
+    EXPECT_EQ(m.find_nth("Dos", 2)->second, 4);
+    EXPECT_EQ(m.get(5)->first, "Cinco");
+    EXPECT_EQ(m.get_at(9), m.end());
+    EXPECT_EQ(m.get_value(8), 8);
+
+    cmap::iterator it = m.end();
+    EXPECT_EQ((--it)->first, "Ocho");
+    EXPECT_EQ((--it)->first, "Dos");
+}
+
+TEST_F(VectorMapTestChunked, Modification) {
+    m.insert({"Nueve", 9}, 4);
+    n.insert({"Nueve", 9}, 4);
+    m.push_front("Diez", 10);
+    n.push_front("Diez", 10);
+    m.emplace_back("Once", 11);
+    n.emplace_back("Once", 11);
+    expect_same_elements();
+    EXPECT_EQ(m.insert({"Doce", 12}, 20), m.end());
+
+    m.set_value(20, "Dos", 2);
+    n.set_value(20, "Dos", 2);
+    m.set_value_at(21, 0);
+    n.set_value_at(21, 0);
+    m.set_key_at("Veinte", 1);
+    n.set_key_at("Veinte", 1);
+    m.set_value_at(22, m.size());
+    m.set_key_at("Veintidos", m.size());
+    expect_same_elements();
+
+    m.erase(3);
+    n.erase(3);
+    m.erase("Dos");
+    n.erase("Dos");
+    expect_same_elements();
+
+    EXPECT_EQ(m.erase_all("Dos"), n.erase_all("Dos"));
+    EXPECT_FALSE(m.contains("Dos"));
+    expect_same_elements();
+
+    m.clear();
+    EXPECT_TRUE(m.is_empty());
+    EXPECT_EQ(m.chunks(), 0);
+    EXPECT_EQ(m.begin(), m.end());
+}
+
+TEST_F(VectorMapTestChunked, MoveAndSwap) {
+    m.move(0, 8);
+    n.move(0, 8);
+    m.move(7, 1);
+    n.move(7, 1);
+    m.move(2, 3);
+    n.move(2, 3);
+    expect_same_elements();
+
+    m.swap(0, 8);
+    n.swap(0, 8);
+    m.swap(4, 5);
+    n.swap(4, 5);
+    expect_same_elements();
+
+    // Swapping across chunks moves the elements instead of copying them.
+    com::chunked_vectormap<std::string, copy_counted, 2> c;
+    for (size_t i = 0; i < 6; ++i) {
+        c.emplace_back(std::to_string(i), i);
+    }
+    ASSERT_GT(c.chunks(), 1);
+    copy_counted::copies = 0;
+    c.swap(0, 5);
+    EXPECT_EQ(copy_counted::copies, 0);
+    EXPECT_EQ(c.get_key(0), "5");
+    EXPECT_EQ(c[0].second.value, 5);
+    EXPECT_EQ(c.get_key(5), "0");
+    EXPECT_EQ(c[5].second.value, 0);
+}
+
+TEST_F(VectorMapTestChunked, RandomEdits) {
+    com::chunked_vectormap<uint64_t, uint64_t, 16> c;
+    com::vectormap<uint64_t, uint64_t> v;
+    std::mt19937_64 gen(11);
+
+    for (uint64_t i = 0; i < 4000; ++i) {
+        const size_t size = v.size();
+        switch (gen() % 4) {
+            case 0:
+            case 1: {
+                size_t pos = gen() % (size + 1);
+                c.insert(i % 53, i, pos);
+                v.insert(i % 53, i, pos);
+                break;
+            }
+            case 2:
+                if (size > 0) {
+                    size_t pos = gen() % size;
+                    c.erase_at(pos);
+                    v.erase_at(pos);
+                }
+                break;
+            default:
+                if (size > 0) {
+                    size_t from = gen() % size;
+                    size_t to = gen() % size;
+                    c.move(from, to);
+                    v.move(from, to);
+                }
+                break;
+        }
+    }
+
+    ASSERT_EQ(c.size(), v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(c[i], v[i]);
+    }
+    EXPECT_EQ(c.get_all_pos(7), v.get_all_pos(7));
+    EXPECT_LE(c.chunks(), v.size() / 4 + 1);
+    for (size_t i = 0; i < c.chunks(); ++i) {
+        EXPECT_LT(c.chunk(i).size(), 32);
+        EXPECT_FALSE(c.chunk(i).is_empty());
+    }
+}
+
+TEST_F(VectorMapTestChunked, CopyOnWrite) {
+    com::chunked_vectormap<uint64_t, uint64_t, 4> c;
+    for (uint64_t i = 0; i < 64; ++i) {
+        c.push_back(i % 8, i);
+    }
+    ASSERT_GT(c.chunks(), 4);
+
+    const com::chunked_vectormap<uint64_t, uint64_t, 4> copy = c;
+    for (size_t i = 0; i < c.chunks(); ++i) {
+        EXPECT_EQ(&copy.chunk(i), &c.chunk(i));
+    }
+
+    // Only the chunk holding the modified element is cloned.
+    c.set_value_at(100, 0);
+    EXPECT_NE(&copy.chunk(0), &c.chunk(0));
+    EXPECT_EQ(&copy.chunk(1), &c.chunk(1));
+    EXPECT_EQ(copy[0].second, 0);
+    EXPECT_EQ(c[0].second, 100);
+
+    com::chunked_vectormap<uint64_t, uint64_t, 4>::snapshot_type snapshot = c.snapshot();
+    c.erase_all(3);
+    c.insert(9, 9, 20);
+    c.move(1, 60);
+    for (auto& elem : c) {
+        ++elem.second;
+    }
+
+    EXPECT_EQ(snapshot->count(3), 8);
+    EXPECT_EQ((*snapshot)[0].second, 100);
+    EXPECT_EQ(copy.get_all_pos(3), snapshot->get_all_pos(3));
+    for (uint64_t i = 1; i < 64; ++i) {
+        EXPECT_EQ(copy[i].first, i % 8);
+        EXPECT_EQ(copy[i].second, i);
+        EXPECT_EQ((*snapshot)[i], copy[i]);
+    }
+    EXPECT_EQ(c.count(3), 0);
+    EXPECT_EQ(c.size(), 57);
+    EXPECT_EQ(c.get_pos(9, 1, 1), std::vector<size_t>({20}));
+}
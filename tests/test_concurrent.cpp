@@ -0,0 +1,119 @@
+#include "concurrent_vectormap.hpp"
+#include "indexed_vectormap.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using cmap = com::concurrent_vectormap<std::string, size_t, 3>;
+
+class VectorMapTestConcurrent : public ::testing::Test {
+    protected:
+        cmap m = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+};
+
+TEST_F(VectorMapTestConcurrent, Access) {
+    EXPECT_EQ(m.size(), 9);
+    EXPECT_FALSE(m.is_empty());
+    EXPECT_EQ(m.get_value("Dos", 2, 2), std::vector<size_t>({4, 7}));
+    EXPECT_EQ(m.get_all_values("Dos"), std::vector<size_t>({2, 4, 7}));
+    EXPECT_EQ(m.count("Dos"), 3);
+    EXPECT_TRUE(m.contains("Ocho"));
+    EXPECT_FALSE(m.contains("Nueve"));
+    EXPECT_EQ(m.read([](const cmap::map_type& map) { return map.get_all_pos("Dos"); }), std::vector<size_t>({2, 4, 7}));
+}
+
+TEST_F(VectorMapTestConcurrent, Snapshots) {
+    cmap::snapshot_type before = m.snapshot();
+
+    m.push_back("Nueve", 9);
+    m.set_value(20, "Dos", 2);
+    m.erase("Cero");
+    EXPECT_EQ(m.size(), 9);
+    EXPECT_EQ(m.get_all_values("Dos"), std::vector<size_t>({2, 20, 7}));
+    EXPECT_FALSE(m.contains("Cero"));
+
+    ASSERT_EQ(before->size(), 9);
+    EXPECT_EQ(before->get_all_values("Dos"), std::vector<size_t>({2, 4, 7}));
+    EXPECT_TRUE(before->contains("Cero"));
+
+    size_t erased = m.update([](cmap::map_type& map) {
+        map.push_back("Diez", 10);
+        return map.erase_all("Dos");
+    });
+    EXPECT_EQ(erased, 3);
+    EXPECT_EQ(m.size(), 7);
+
+    // A reference returned by f would outlive its version: update returns a copy.
+    auto first = [](cmap::map_type& map) -> size_t& { return map.get_value_at(0); };
+    static_assert(std::is_same_v<decltype(m.update(first)), size_t>);
+    size_t value = m.update(first);
+    m.clear();
+    EXPECT_EQ(value, 1);
+
+    m.publish(cmap::map_type({{"Uno", 1}}));
+    EXPECT_EQ(m.size(), 1);
+    m.clear();
+    EXPECT_TRUE(m.is_empty());
+    EXPECT_EQ(before->size(), 9);
+}
+
+TEST_F(VectorMapTestConcurrent, Threads) {
+    com::concurrent_vectormap<size_t, size_t, 100, com::hash_index<size_t>> p;
+    constexpr size_t total = 2000;
+    std::atomic<bool> done = false;
+    std::atomic<size_t> torn = 0;
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < 4; ++r) {
+        readers.emplace_back([&]() {
+            size_t last = 0;
+            while (!done.load()) {
+                auto s = p.snapshot();
+                // Every snapshot is a prefix of the final contents, written in batches of ten.
+                if ((s->size() < last) || (s->size() % 10 != 0)) {
+                    ++torn;
+                }
+                for (size_t i = 0; i < s->size(); ++i) {
+                    if (((*s)[i].first != i) || ((*s)[i].second != 2 * i)) {
+                        ++torn;
+                    }
+                }
+                if (!s->is_empty() && (s->get_all_values(s->size() - 1) != std::vector<size_t>({2 * (s->size() - 1)}))) {
+                    ++torn;
+                }
+                last = s->size();
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    std::atomic<size_t> next = 0;
+    for (size_t w = 0; w < 2; ++w) {
+        writers.emplace_back([&]() {
+            for (size_t b = 0; b < total / 20; ++b) {
+                p.update([&](auto& map) {
+                    for (size_t k = 0; k < 10; ++k) {
+                        size_t i = next++;
+                        map.push_back(i, 2 * i);
+                    }
+                });
+            }
+        });
+    }
+
+    for (auto& t : writers) {
+        t.join();
+    }
+    done = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(p.size(), total);
+    EXPECT_EQ(p.get_value(total - 1), std::vector<size_t>({2 * (total - 1)}));
+}
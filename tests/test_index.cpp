@@ -0,0 +1,407 @@
+#include "indexed_vectormap.hpp"
+#include "gtest/gtest.h"
+
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+
+using vmap = com::vectormap<std::string, size_t, 3>;
+using imap = com::indexed_vectormap<std::string, size_t, 3>;
+
+class VectorMapTestIndex : public ::testing::Test {
+    protected:
+        vmap n = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+        imap m = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+
+        void expect_same_positions() {
+            ASSERT_EQ(m.size(), n.size());
+            for (vmap::size_type i = 0; i < n.size(); ++i) {
+                EXPECT_EQ(m.get_all_pos(n.get_key(i)), n.get_all_pos(n.get_key(i)));
+            }
+        }
+};
+
+TEST_F(VectorMapTestIndex, GetByKey) {
+    std::vector<imap::iterator_pos> v = m.get("Dos", 2, 2);
+
+    ASSERT_EQ(v.size(), 2);
+    EXPECT_EQ(v.at(0).first->second, 4);
+    EXPECT_EQ(v.at(0).second, 4);
+    EXPECT_EQ(v.at(1).first->second, 7);
+    EXPECT_EQ(v.at(1).second, 7);
+    EXPECT_EQ(m.index().keys(), 7);
+    EXPECT_EQ(m.index().positions("Nueve"), nullptr);
+}
+
+TEST_F(VectorMapTestIndex, Insert) {
+    n.insert({"Dos", 9}, 1);
+    m.insert({"Dos", 9}, 1);
+    n.push_front({{"Tres", 10}, {"Dos", 11}});
+    m.push_front({{"Tres", 10}, {"Dos", 11}});
+    n.push_back("Dos", 12);
+    m.push_back("Dos", 12);
+
+    expect_same_positions();
+    EXPECT_EQ(m.get_all_values("Dos"), n.get_all_values("Dos"));
+}
+
+TEST_F(VectorMapTestIndex, Erase) {
+    n.erase(3);
+    m.erase(3);
+    n.erase("Dos");
+    m.erase("Dos");
+    n.erase(n.size() - 1);
+    m.erase(m.size() - 1);
+    expect_same_positions();
+
+    n.erase_all("Dos");
+    m.erase_all("Dos");
+    expect_same_positions();
+    EXPECT_EQ(m.index().positions("Dos"), nullptr);
+
+    n.erase({0, 2});
+    m.erase({0, 2});
+    expect_same_positions();
+    n.erase_if([](const vmap::value_type& elem) { return elem.second > 5; });
+    m.erase_if([](const imap::value_type& elem) { return elem.second > 5; });
+    expect_same_positions();
+    EXPECT_EQ(m.get_all_pos("Uno"), std::vector<imap::size_type>({0}));
+}
+
+TEST_F(VectorMapTestIndex, MoveAndSwap) {
+    n.move(7, 1);
+    m.move(7, 1);
+    expect_same_positions();
+
+    n.move(0, 5);
+    m.move(0, 5);
+    expect_same_positions();
+
+    n.swap(2, 8);
+    m.swap(2, 8);
+    expect_same_positions();
+}
+
+TEST_F(VectorMapTestIndex, SetKey) {
+    m.set_key("Nueve", 4);
+    m.set_key("Dos", "Seis");
+
+    EXPECT_EQ(m.get_all_pos("Nueve"), std::vector<imap::size_type>({4}));
+    EXPECT_EQ(m.get_all_pos("Dos"), std::vector<imap::size_type>({2, 6, 7}));
+    EXPECT_EQ(m.get_all_pos("Seis"), std::vector<imap::size_type>());
+    EXPECT_EQ(m.get_value(6), 6);
+}
+
+TEST_F(VectorMapTestIndex, CopyAndClear) {
+    imap p = m;
+    m.clear();
+
+    EXPECT_EQ(m.get_all("Dos").size(), 0);
+    EXPECT_EQ(p.get_all_pos("Dos"), std::vector<imap::size_type>({2, 4, 7}));
+
+    m = p;
+    EXPECT_EQ(m.size(), 9);
+    EXPECT_EQ(m.get_all_pos("Dos"), std::vector<imap::size_type>({2, 4, 7}));
+}
+
+TEST_F(VectorMapTestIndex, Find) {
+    EXPECT_EQ(m.find("Dos")->second, 2);
+    EXPECT_EQ(m.find_nth("Dos", 3)->second, 7);
+    EXPECT_EQ(m.find_nth("Dos", 4), m.end());
+    EXPECT_EQ(m.count("Dos"), 3);
+    EXPECT_EQ(m.count("Nueve"), 0);
+    EXPECT_TRUE(m.contains("Seis"));
+
+    std::vector<imap::mapped_type> v;
+    for (auto& elem : m.equal_range_view("Dos")) {
+        v.push_back(elem.second);
+    }
+    EXPECT_EQ(v, std::vector<imap::mapped_type>({2, 4, 7}));
+    EXPECT_EQ(std::ranges::distance(m.equal_range_view("Nueve")), 0);
+}
+
+TEST_F(VectorMapTestIndex, FrontGap) {
+    com::vectormap<std::string, size_t, 3, com::hash_index<std::string>, com::front_gap<>> p = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}};
+
+    p.push_front("Dos", 10);
+    p.erase_at(1);
+    p.push_front({{"Uno", 11}, {"Dos", 12}});
+    p.erase_at(0);
+
+    EXPECT_EQ(p.get_all_pos("Dos"), std::vector<size_t>({0, 1, 3, 5}));
+    EXPECT_EQ(p.get_all_pos("Uno"), std::vector<size_t>({2}));
+    EXPECT_EQ(p.get_all_pos("Tres"), std::vector<size_t>({4}));
+    EXPECT_FALSE(p.contains("Cero"));
+    EXPECT_EQ(p.get_value("Dos", 2).at(0), 10);
+}
+
+TEST_F(VectorMapTestIndex, FindNextPos) {
+    EXPECT_EQ(m.find_next_pos("Dos", 0), 2);
+    EXPECT_EQ(m.find_next_pos("Dos", 3), 4);
+    EXPECT_EQ(m.find_next_pos("Dos", 8), imap::npos);
+    EXPECT_EQ(m.find_next_pos("Nueve", 0), imap::npos);
+    for (imap::size_type i = 0; i <= n.size(); ++i) {
+        EXPECT_EQ(m.find_next_pos("Dos", i), n.find_next_pos("Dos", i));
+    }
+}
+
+TEST_F(VectorMapTestIndex, OrdinalJump) {
+    com::instrumented_vectormap<size_t, size_t, 100, com::hash_index<size_t>> p;
+    for (size_t i = 0; i < 10000; ++i) {
+        p.push_back(i % 2, i);
+    }
+
+    // The index goes straight to the ordinal-th occurrence, only the returned entries are visited.
+    p.reset_stats();
+    EXPECT_EQ(p.get_pos(0, 4000, 3), std::vector<size_t>({7998, 8000, 8002}));
+    EXPECT_EQ(p.get_value(1, 5000, 2), std::vector<size_t>({9999}));
+    EXPECT_EQ(p.get(1, 5001).size(), 0);
+    EXPECT_EQ(p.stats().lookups, 3);
+    EXPECT_EQ(p.stats().compared, 4);
+
+    EXPECT_EQ(p.find_next_pos(1, 5000), 5001);
+    EXPECT_EQ(p.stats().compared, 5);
+}
+
+TEST_F(VectorMapTestIndex, TransparentLookup) {
+    com::indexed_vectormap<std::string, size_t, 3, com::string_hash, std::equal_to<>> p = {{"Cero", 0}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}};
+    static_assert(decltype(p)::index_type::transparent);
+
+    const std::string_view dos = "Dos";
+    EXPECT_EQ(p.get_all_pos(dos), std::vector<size_t>({1, 3}));
+    EXPECT_EQ(p.count("Dos"), 2);
+    EXPECT_NE(p.index().positions(dos), nullptr);
+    EXPECT_EQ(p.erase_all(dos), 2);
+    EXPECT_FALSE(p.contains(dos));
+
+    // Without a transparent hash the key is built once for the index.
+    static_assert(!imap::index_type::transparent);
+    EXPECT_EQ(m.get_all_pos(dos), std::vector<size_t>({2, 4, 7}));
+    EXPECT_EQ(m.find(dos)->second, 2);
+}
+
+namespace {
+    // Counts the key comparisons made by the scans.
+    struct counted_key {
+        std::string text;
+        static inline size_t compared = 0;
+
+        bool operator==(const counted_key& other) const { ++compared; return text == other.text; }
+    };
+
+    struct counted_hash {
+        size_t operator()(const counted_key& key) const { return std::hash<std::string>()(key.text); }
+    };
+}
+
+TEST_F(VectorMapTestIndex, Fingerprints) {
+    com::fingerprint_vectormap<std::string, size_t, 3> p = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+    std::mt19937_64 gen(3);
+
+    for (size_t i = 0; i < 300; ++i) {
+        const std::string key = "K" + std::to_string(gen() % 20);
+        const size_t pos = gen() % (n.size() + 1);
+        switch (gen() % 6) {
+            case 0: n.insert(key, i, pos); p.insert(key, i, pos); break;
+            case 1: n.push_front(key, i); p.push_front(key, i); break;
+            case 2: if (pos < n.size()) { n.erase_at(pos); p.erase_at(pos); } break;
+            case 3: if (pos < n.size()) { n.move(pos, n.size() - 1 - pos); p.move(pos, p.size() - 1 - pos); } break;
+            case 4: if (pos < n.size()) { n.swap(pos, 0); p.swap(pos, 0); } break;
+            default: if (pos < n.size()) { n.set_key_at(key, pos); p.set_key_at(key, pos); } break;
+        }
+    }
+    EXPECT_EQ(p.erase_all("K3"), n.erase_all("K3"));
+
+    ASSERT_EQ(p.size(), n.size());
+    ASSERT_EQ(p.index().fingerprints().size(), p.size());
+    for (size_t i = 0; i < n.size(); ++i) {
+        EXPECT_EQ(p[i], n[i]);
+        EXPECT_EQ(p.index().fingerprints()[i], decltype(p)::index_type::fingerprint(n.get_key(i)));
+    }
+    for (size_t k = 0; k < 20; ++k) {
+        const std::string key = "K" + std::to_string(k);
+        EXPECT_EQ(p.get_all_pos(key), n.get_all_pos(key));
+    }
+    EXPECT_EQ(p.count("Dos"), n.count("Dos"));
+
+    p.clear();
+    EXPECT_TRUE(p.index().fingerprints().empty());
+}
+
+TEST_F(VectorMapTestIndex, FingerprintsSkipComparisons) {
+    com::vectormap<counted_key, size_t, 100, com::fingerprint_index<counted_key, counted_hash>> p;
+    for (size_t i = 0; i < 10000; ++i) {
+        p.push_back(counted_key{"https://example.com/some/long/shared/prefix/" + std::to_string(i)}, i);
+    }
+
+    counted_key::compared = 0;
+    ASSERT_EQ(p.get_all_pos(counted_key{"https://example.com/some/long/shared/prefix/5000"}), std::vector<size_t>({5000}));
+    EXPECT_LT(counted_key::compared, 200);
+}
+
+TEST_F(VectorMapTestIndex, SortedIndex) {
+    com::sorted_vectormap<std::string, size_t, 3> p = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+    std::mt19937_64 gen(5);
+
+    auto expect_sorted = [&]() {
+        ASSERT_EQ(p.size(), n.size());
+        std::vector<size_t> expected(n.size());
+        std::iota(expected.begin(), expected.end(), 0);
+        std::stable_sort(expected.begin(), expected.end(), [&](size_t a, size_t b) { return n.get_key(a) < n.get_key(b); });
+        EXPECT_EQ(p.index().sorted(), expected);
+        for (size_t i = 0; i < n.size(); ++i) {
+            EXPECT_EQ(p[i], n[i]);
+        }
+    };
+    expect_sorted();
+
+    for (size_t i = 0; i < 300; ++i) {
+        const std::string key = "K" + std::to_string(gen() % 20);
+        const size_t pos = gen() % (n.size() + 1);
+        switch (gen() % 8) {
+            case 0: n.insert(key, i, pos); p.insert(key, i, pos); break;
+            case 1: n.push_back(key, i); p.push_back(key, i); break;
+            case 2: n.insert({{key, i}, {"K0", i}, {"A", i}}, pos); p.insert({{key, i}, {"K0", i}, {"A", i}}, pos); break;
+            case 3: if (pos < n.size()) { n.erase_at(pos); p.erase_at(pos); } break;
+            case 4: if (pos < n.size()) { n.move(pos, n.size() - 1 - pos); p.move(pos, p.size() - 1 - pos); } break;
+            case 5: if (pos < n.size()) { n.swap(pos, 0); p.swap(pos, 0); } break;
+            case 6: if (!n.is_empty()) { n.erase_at(n.size() - 1); p.erase_at(p.size() - 1); } break;
+            default: if (pos < n.size()) { n.set_key_at(key, pos); p.set_key_at(key, pos); } break;
+        }
+    }
+    expect_sorted();
+    EXPECT_EQ(p.erase_all("K3"), n.erase_all("K3"));
+    expect_sorted();
+
+    for (size_t k = 0; k < 20; ++k) {
+        const std::string key = "K" + std::to_string(k);
+        EXPECT_EQ(p.get_all_pos(key), n.get_all_pos(key));
+        EXPECT_EQ(p.find_nth(key, 2) - p.begin(), n.find_nth(key, 2) - n.begin());
+    }
+    EXPECT_EQ(p.count("A"), n.count("A"));
+
+    p.clear();
+    EXPECT_TRUE(p.index().sorted().empty());
+}
+
+TEST_F(VectorMapTestIndex, SortedRanges) {
+    com::sorted_vectormap<std::string, size_t, 3> p = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+
+    std::vector<size_t> values;
+    for (const auto& elem : p.sorted_view()) {
+        values.push_back(elem.second);
+    }
+    EXPECT_EQ(values, std::vector<size_t>({0, 5, 2, 4, 7, 8, 6, 3, 1}));
+    EXPECT_EQ(p.get_key(0), "Cero");
+
+    values.clear();
+    for (const auto& elem : p.range_view("D", "S")) {
+        values.push_back(elem.second);
+    }
+    EXPECT_EQ(values, std::vector<size_t>({2, 4, 7, 8}));
+    EXPECT_EQ(std::ranges::distance(p.range_view(std::string_view("D"), std::string_view("S"))), 4);
+    EXPECT_TRUE(std::ranges::empty(p.range_view("S", "D")));
+    EXPECT_TRUE(std::ranges::empty(p.range_view("V", "Z")));
+
+    for (auto& elem : p.range_view("Cero", "Cinco")) {
+        elem.second = 10;
+    }
+    EXPECT_EQ(p.get_value_at(0), 10);
+
+    const auto& index = p.index();
+    auto dos = index.equal_range(p, std::string("Dos"));
+    EXPECT_EQ(std::vector<size_t>(dos.begin(), dos.end()), std::vector<size_t>({2, 4, 7}));
+    EXPECT_EQ(*index.lower_bound(p, std::string("E")), 8);
+    EXPECT_EQ(*index.upper_bound(p, std::string("Dos")), 8);
+    EXPECT_EQ(index.upper_bound(p, std::string("Uno")), index.sorted().end());
+}
+
+TEST_F(VectorMapTestIndex, StableHandles) {
+    com::stable_vectormap<std::string, size_t, 3, com::hash_index<std::string>> p = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+    std::vector<com::stable_handle> handles;
+    std::vector<bool> erased;
+    for (size_t i = 0; i < p.size(); ++i) {
+        handles.push_back(p.handle_at(i));
+        erased.push_back(false);
+    }
+    std::mt19937_64 gen(9);
+
+    // Every value is unique: the handle taken when it was added must still lead to it.
+    for (size_t i = p.size(); i < 600; ++i) {
+        const std::string key = "K" + std::to_string(gen() % 20);
+        const size_t pos = gen() % (p.size() + 1);
+        switch (gen() % 8) {
+            case 0: p.insert(key, i, pos); handles.push_back(p.handle_at(pos)); break;
+            case 1: p.push_back(key, i); handles.push_back(p.handle_at(p.size() - 1)); break;
+            case 2: if (pos < p.size()) { erased[p.get_value_at(pos)] = true; p.erase_at(pos); } break;
+            case 3: if (pos < p.size()) { p.move(pos, p.size() - 1 - pos); } break;
+            case 4: if (pos < p.size()) { p.swap(pos, 0); } break;
+            case 5: if (p.size() > 40) { p.shrink(); } break;
+            case 6:
+                for (const auto& elem : p) {
+                    erased[elem.second] = erased[elem.second] || (elem.second % 29 == i % 29);
+                }
+                p.erase_if([&](const auto& elem) { return elem.second % 29 == i % 29; });
+                break;
+            default: if (pos < p.size()) { p.set_key_at(key, pos); } break;
+        }
+        handles.resize(i + 1);
+        erased.resize(i + 1, handles[i] == com::stable_handle());
+    }
+
+    for (size_t value = 0; value < handles.size(); ++value) {
+        if (erased[value]) {
+            EXPECT_EQ(p.resolve(handles[value]), p.end());
+            EXPECT_EQ(p.resolve_pos(handles[value]), p.npos);
+        }
+        else {
+            ASSERT_NE(p.resolve(handles[value]), p.end());
+            EXPECT_EQ(p.resolve(handles[value])->second, value);
+            EXPECT_EQ(p.handle_at(p.resolve_pos(handles[value])), handles[value]);
+        }
+    }
+    for (size_t k = 0; k < 20; ++k) {
+        const std::string key = "K" + std::to_string(k);
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < p.size(); ++i) {
+            if (p.get_key(i) == key) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(p.get_all_pos(key), expected);
+    }
+    EXPECT_EQ(p.handle_at(p.size()), com::stable_handle());
+    EXPECT_EQ(p.resolve(com::stable_handle()), p.end());
+
+    const com::stable_handle first = p.handle_at(0);
+    p.clear();
+    EXPECT_EQ(p.resolve(first), p.end());
+    p.push_back("Cero", 0);
+    EXPECT_EQ(p.resolve(first), p.end());
+}
+
+TEST_F(VectorMapTestIndex, AppendBatch) {
+    com::stable_vectormap<std::string, size_t> p;
+    std::vector<com::stable_handle> handles;
+
+    p.append_batch(n, std::back_inserter(handles));
+    const size_t dos = p.find_nth("Dos", 2) - p.begin();
+    const com::stable_handle cached = p.handle_at(dos);
+    for (size_t round = 1; round < 20; ++round) {
+        p.append_batch(n, std::back_inserter(handles));
+        EXPECT_EQ(p.resolve(cached)->second, 4);
+    }
+    p.erase_all("Dos");
+
+    ASSERT_EQ(handles.size(), 20 * n.size());
+    for (size_t i = 0; i < handles.size(); ++i) {
+        if (n.get_key(i % n.size()) == "Dos") {
+            EXPECT_EQ(p.resolve(handles[i]), p.end());
+        }
+        else {
+            EXPECT_EQ(p.resolve(handles[i])->second, i % n.size());
+        }
+    }
+    EXPECT_EQ(p.resolve(cached), p.end());
+}
@@ -1,6 +1,13 @@
 #include "vectormap.hpp"
 #include "gtest/gtest.h"
 
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
 using  vmap = com::vectormap<std::string, size_t, 3>;
 
 class VectorMapTestInsertion : public ::testing::Test {
@@ -180,3 +187,212 @@ TEST_F(VectorMapTestInsertion, PushFrontVectormap) {
     EXPECT_EQ(it->first, "Nueve");
     EXPECT_EQ(it->second, 9);
 }
+
+TEST_F(VectorMapTestInsertion, Emplace) {
+    vmap::iterator it = n.emplace(3, "Nueve", 9);
+
+    ASSERT_EQ(n.size(), 10);
+    EXPECT_EQ(n.data()[3].first, "Nueve");
+    EXPECT_EQ(n.data()[3].second, 9);
+    EXPECT_EQ(n.data()[4].first, "Tres");
+    EXPECT_EQ(it->first, "Nueve");
+
+    it = n.emplace_back(std::piecewise_construct, std::forward_as_tuple(3, 'X'), std::forward_as_tuple(10));
+    EXPECT_EQ(n.data()[10].first, "XXX");
+    EXPECT_EQ(it->second, 10);
+
+    it = n.emplace_front("Once", 11);
+    EXPECT_EQ(n.data()[0].first, "Once");
+    EXPECT_EQ(n.size(), 12);
+
+    EXPECT_EQ(n.emplace(20, "Fuera", 20), n.end());
+}
+
+TEST_F(VectorMapTestInsertion, EmplaceAliasing) {
+    n.emplace(1, n.get_key(8), n.get_value(8));
+    while (n.size() < n.capacity()) {
+        n.push_back("Relleno", 0);
+    }
+    n.emplace_back(n.get_key(1), n.get_value(1));
+
+    ASSERT_EQ(n.size(), 13);
+    EXPECT_EQ(n.capacity(), 15);
+    EXPECT_EQ(n.data()[1].first, "Ocho");
+    EXPECT_EQ(n.data()[12].first, "Ocho");
+    EXPECT_EQ(n.data()[12].second, 8);
+}
+
+TEST_F(VectorMapTestInsertion, MoveOnlyValues) {
+    com::vectormap<std::string, std::unique_ptr<size_t>, 3> m;
+    auto ptr = std::make_unique<size_t>(1);
+    size_t* raw = ptr.get();
+
+    m.push_back("Uno", std::move(ptr));
+    m.emplace_front("Cero", std::make_unique<size_t>(0));
+    m.insert(std::make_pair(std::string("Dos"), std::make_unique<size_t>(2)), 1);
+    m.push_back({"Tres", std::make_unique<size_t>(3)});
+
+    ASSERT_EQ(m.size(), 4);
+    EXPECT_EQ(m.data()[2].second.get(), raw);
+    EXPECT_EQ(*m.data()[0].second, 0);
+    EXPECT_EQ(*m.data()[1].second, 2);
+    EXPECT_EQ(*m.data()[3].second, 3);
+}
+
+TEST_F(VectorMapTestInsertion, InsertMovedVectormap) {
+    vmap p = {{"Nueve", 9}, {"Diez", 10}};
+    vmap::iterator it = n.insert(std::move(p), 3);
+
+    ASSERT_EQ(n.size(), 11);
+    EXPECT_EQ(n.data()[3].first, "Nueve");
+    EXPECT_EQ(n.data()[4].first, "Diez");
+    EXPECT_EQ(n.data()[5].first, "Tres");
+    EXPECT_EQ(it->second, 9);
+    EXPECT_EQ(p.size(), 0);
+}
+
+TEST_F(VectorMapTestInsertion, FrontGap) {
+    com::deque_vectormap<std::string, size_t, 3> m = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Cuatro", 4}, {"Cinco", 5}, {"Seis", 6}, {"Siete", 7}, {"Ocho", 8}};
+    static_assert(decltype(m)::front_gap_enabled && !vmap::front_gap_enabled);
+
+    auto expect_same = [&]() {
+        ASSERT_EQ(m.size(), n.size());
+        for (vmap::size_type i = 0; i < n.size(); ++i) {
+            EXPECT_EQ(m[i], n[i]);
+        }
+    };
+
+    for (size_t i = 10; i < 40; ++i) {
+        m.push_front(std::to_string(i), i);
+        n.push_front(std::to_string(i), i);
+        m.push_back("Atras", i);
+        n.push_back("Atras", i);
+    }
+    expect_same();
+
+    m.push_front({{"A", 100}, {"B", 101}});
+    n.push_front({{"A", 100}, {"B", 101}});
+    m.insert({"C", 102}, 5);
+    n.insert({"C", 102}, 5);
+    m.emplace(2, "D", 103);
+    n.emplace(2, "D", 103);
+    expect_same();
+
+    for (size_t i = 0; i < 20; ++i) {
+        m.erase_at(0);
+        n.erase_at(0);
+        m.erase_at(3);
+        n.erase_at(3);
+    }
+    expect_same();
+
+    m.erase_all("Atras");
+    n.erase_all("Atras");
+    expect_same();
+
+    com::deque_vectormap<std::string, size_t, 3> p = m;
+    com::deque_vectormap<std::string, size_t, 3> q = std::move(m);
+    EXPECT_EQ(q.size(), n.size());
+    swap(p, q);
+    EXPECT_EQ(p.get_all_pos("Cero"), n.get_all_pos("Cero"));
+
+    p.clear();
+    p.push_front("Uno", 1);
+    p.push_front("Cero", 0);
+    EXPECT_EQ(p.get_key_at(0), "Cero");
+    EXPECT_TRUE(p.shrink());
+    EXPECT_EQ(p.capacity(), 2);
+    EXPECT_EQ(p.get_key_at(1), "Uno");
+}
+
+TEST_F(VectorMapTestInsertion, FrontGapConstantTime) {
+    com::vectormap<size_t, size_t, 16, com::no_index, com::front_gap<>, std::allocator<std::pair<const size_t, size_t>>, 0, com::counting_stats> m;
+    for (size_t i = 0; i < 10000; ++i) {
+        m.push_front(i, i);
+    }
+    // Recentring and reallocating relocate every element a constant number of times on average.
+    EXPECT_LT(m.stats().relocations, 4 * 10000);
+    EXPECT_LT(m.stats().allocations, 20);
+
+    m.reset_stats();
+    for (size_t i = 0; i < 10000; ++i) {
+        m.erase_at(0);
+        m.push_front(i, i);
+        m.push_back(i, i);
+        m.erase_at(m.size() - 1);
+    }
+    EXPECT_LT(m.stats().relocations, 4 * 20000);
+    EXPECT_EQ(m.get_value_at(0), 9999);
+    EXPECT_EQ(m.get_value_at(9999), 0);
+}
+
+TEST_F(VectorMapTestInsertion, InsertIteratorRange) {
+    std::vector<std::pair<std::string, size_t>> v = {{"Nueve", 9}, {"Diez", 10}, {"Once", 11}};
+    vmap::iterator it = n.insert(2, v.begin(), v.end());
+
+    ASSERT_EQ(n.size(), 12);
+    EXPECT_EQ(n.capacity(), 12);
+    EXPECT_EQ(it->first, "Nueve");
+    EXPECT_EQ(n.data()[4].first, "Once");
+    EXPECT_EQ(n.data()[5].first, "Dos");
+    EXPECT_EQ(v[0].first, "Nueve");
+
+    EXPECT_EQ(n.insert(20, v.begin(), v.end()), n.end());
+    EXPECT_EQ(n.size(), 12);
+
+    vmap m(v.begin(), v.end());
+    ASSERT_EQ(m.size(), 3);
+    EXPECT_EQ(m.get_key_at(2), "Once");
+}
+
+TEST_F(VectorMapTestInsertion, InsertRange) {
+    std::list<std::pair<std::string, size_t>> l = {{"Nueve", 9}, {"Diez", 10}};
+    n.insert_range(0, l);
+    n.append_range(std::vector<std::pair<const std::string, size_t>>{{"Once", 11}});
+
+    ASSERT_EQ(n.size(), 12);
+    EXPECT_EQ(n.get_key_at(0), "Nueve");
+    EXPECT_EQ(n.get_key_at(2), "Cero");
+    EXPECT_EQ(n.get_key_at(11), "Once");
+    EXPECT_EQ(l.size(), 2);
+
+    // A single-pass range.
+    std::istringstream input("1 2 3");
+    com::vectormap<size_t, size_t> m = {{0, 0}, {4, 4}};
+    m.insert_range(1, std::views::istream<size_t>(input) | std::views::transform([](size_t i) { return std::make_pair(i, i * 10); }));
+    ASSERT_EQ(m.size(), 5);
+    EXPECT_EQ(m.get_value_at(3), 30);
+    EXPECT_EQ(m.get_key_at(4), 4);
+}
+
+TEST_F(VectorMapTestInsertion, InsertRangeMoves) {
+    std::vector<std::pair<std::string, std::unique_ptr<size_t>>> v;
+    v.emplace_back("Uno", std::make_unique<size_t>(1));
+    v.emplace_back("Dos", std::make_unique<size_t>(2));
+    size_t* raw = v[1].second.get();
+
+    com::vectormap<std::string, std::unique_ptr<size_t>, 3> m;
+    m.emplace_back("Cero", std::make_unique<size_t>(0));
+    m.append_range(std::move(v));
+
+    ASSERT_EQ(m.size(), 3);
+    EXPECT_EQ(m.data()[2].second.get(), raw);
+    EXPECT_EQ(*m.data()[1].second, 1);
+
+    vmap p = {{"Nueve", 9}, {"Diez", 10}};
+    n.insert_range(1, std::move(p));
+    EXPECT_EQ(n.get_key_at(2), "Diez");
+    EXPECT_EQ(p.size(), 0);
+}
+
+TEST_F(VectorMapTestInsertion, InsertRangeGrowsOnce) {
+    com::vectormap<size_t, size_t, 16, com::no_index, com::delta_growth, std::allocator<std::pair<const size_t, size_t>>, 0, com::counting_stats> m;
+    m.push_back(0, 0);
+    m.reset_stats();
+
+    m.append_range(std::views::iota(size_t(1), size_t(100001)) | std::views::transform([](size_t i) { return std::make_pair(i, i); }));
+    ASSERT_EQ(m.size(), 100001);
+    EXPECT_EQ(m.stats().allocations, 1);
+    EXPECT_EQ(m.stats().relocations, 1);
+    EXPECT_EQ(m.get_value_at(100000), 100000);
+}
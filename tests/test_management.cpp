@@ -0,0 +1,385 @@
+#include "vectormap.hpp"
+#include "indexed_vectormap.hpp"
+#include "vectormap_parallel.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using vmap = com::vectormap<std::string, size_t, 3>;
+
+struct counted_key {
+    static inline size_t copies = 0;
+    static inline size_t moves = 0;
+
+    std::string name;
+
+    counted_key(const char* n = "") : name(n) {}
+    counted_key(const counted_key& other) : name(other.name) { ++copies; }
+    counted_key(counted_key&& other) noexcept : name(std::move(other.name)) { ++moves; }
+    counted_key& operator=(const counted_key&) = default;
+    bool operator==(const counted_key& other) const { return name == other.name; }
+};
+
+struct plain_key {
+    int id;
+    plain_key(int i = 0) : id(i) {}
+    bool operator==(const plain_key&) const = default;
+};
+
+// Value whose copies and moves throw when the source is poisoned; assigning never throws.
+struct fragile {
+    size_t value;
+    bool poisoned;
+
+    fragile(size_t v = 0, bool p = false) : value(v), poisoned(p) {}
+    fragile(const fragile& other) : value(other.value), poisoned(other.poisoned) { if (poisoned) throw std::runtime_error("copy"); }
+    fragile(fragile&& other) noexcept(false) : value(other.value), poisoned(other.poisoned) { if (poisoned) throw std::runtime_error("move"); }
+    fragile& operator=(const fragile&) = default;
+    bool operator==(const fragile& other) const { return value == other.value; }
+};
+
+// Value whose copy constructor throws once copies_left copies have been made; alive counts the instances.
+struct countdown {
+    static inline size_t copies_left = std::numeric_limits<size_t>::max();
+    static inline long alive = 0;
+    size_t value;
+
+    countdown(size_t v = 0) : value(v) { ++alive; }
+    countdown(const countdown& other) : value(other.value) {
+        if (copies_left-- == 0) {
+            copies_left = std::numeric_limits<size_t>::max();
+            throw std::runtime_error("copy");
+        }
+        ++alive;
+    }
+    countdown& operator=(const countdown&) = default;
+    ~countdown() { --alive; }
+};
+
+struct fragile_hash {
+    size_t operator()(const fragile& key) const { return std::hash<size_t>()(key.value); }
+};
+
+using cmap = com::vectormap<counted_key, size_t, 3>;
+using pmap = com::vectormap<plain_key, size_t, 3>;
+
+class VectorMapTestManagement : public ::testing::Test {
+    protected:
+        vmap n = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Cuatro", 4}, {"Cinco", 5}};
+
+        template<class map_>
+        std::vector<size_t> values(map_& map) {
+            std::vector<size_t> out;
+            for (auto it = map.begin(); it != map.end(); ++it) {
+                out.push_back(it->second);
+            }
+            return out;
+        }
+};
+
+TEST_F(VectorMapTestManagement, EraseByPos) {
+    n.erase(1);
+
+    ASSERT_EQ(n.size(), 5);
+    EXPECT_EQ(values(n), std::vector<size_t>({0, 2, 3, 4, 5}));
+    EXPECT_EQ(n.get_key(1), "Dos");
+}
+
+TEST_F(VectorMapTestManagement, EraseByList) {
+    n.erase({4, 1, 5, 1, 9});
+
+    ASSERT_EQ(n.size(), 3);
+    EXPECT_EQ(values(n), std::vector<size_t>({0, 2, 3}));
+}
+
+TEST_F(VectorMapTestManagement, EraseIf) {
+    EXPECT_EQ(n.erase_if([](const vmap::value_type& elem) { return elem.second % 2 == 0; }), 3);
+    EXPECT_EQ(values(n), std::vector<size_t>({1, 3, 5}));
+
+    std::vector<vmap::size_type> positions = {0, 2};
+    EXPECT_EQ(n.erase_positions(positions), 2);
+    EXPECT_EQ(values(n), std::vector<size_t>({3}));
+    EXPECT_EQ(n.erase_if([](const vmap::value_type&) { return false; }), 0);
+}
+
+TEST_F(VectorMapTestManagement, EraseAll) {
+    cmap m;
+    for (size_t i = 0; i < 30; ++i) {
+        m.push_back(counted_key(i % 3 == 0 ? "Old" : "New"), i);
+    }
+
+    counted_key::moves = 0;
+    EXPECT_EQ(m.erase_all(counted_key("Old")), 10);
+    EXPECT_EQ(m.size(), 20);
+    EXPECT_EQ(m.count(counted_key("Old")), 0);
+    EXPECT_EQ(m.get_value_at(0), 1);
+    EXPECT_EQ(m.get_value_at(19), 29);
+    // Every survivor is moved exactly once.
+    EXPECT_EQ(counted_key::moves, 20);
+}
+
+TEST_F(VectorMapTestManagement, EraseIfThrows) {
+    size_t calls = 0;
+    auto pred = [&](const vmap::value_type& elem) {
+        if (++calls == 4) {
+            throw std::runtime_error("pred");
+        }
+        return elem.second == 1;
+    };
+
+    EXPECT_THROW(n.erase_if(pred), std::runtime_error);
+    EXPECT_EQ(values(n), std::vector<size_t>({0, 2, 3, 4, 5}));
+}
+
+TEST_F(VectorMapTestManagement, ParallelEraseIf) {
+    com::vectormap<size_t, size_t> p;
+    for (size_t i = 0; i < 100000; ++i) {
+        p.push_back(i % 10, i);
+    }
+
+    EXPECT_EQ(com::erase_if(std::execution::par, p, [](const auto& elem) { return elem.first % 2 == 0; }), 50000);
+    ASSERT_EQ(p.size(), 50000);
+    for (size_t i = 0; i < p.size(); ++i) {
+        EXPECT_EQ(p[i].second, 2 * i + 1);
+    }
+}
+
+TEST_F(VectorMapTestManagement, MoveBackward) {
+    n.move(4, 1);
+
+    ASSERT_EQ(n.size(), 6);
+    EXPECT_EQ(values(n), std::vector<size_t>({0, 4, 1, 2, 3, 5}));
+    EXPECT_EQ(n.get_key(1), "Cuatro");
+}
+
+TEST_F(VectorMapTestManagement, MoveForward) {
+    n.move(1, 4);
+
+    ASSERT_EQ(n.size(), 6);
+    EXPECT_EQ(values(n), std::vector<size_t>({0, 2, 3, 4, 1, 5}));
+    EXPECT_EQ(n.get_key(4), "Uno");
+}
+
+TEST_F(VectorMapTestManagement, RelocationMovesKeys) {
+    cmap m;
+    for (size_t i = 0; i < 20; ++i) {
+        m.push_back(counted_key("Key"), i);
+    }
+
+    m.insert(counted_key("Mid"), 7, 10);
+
+    counted_key::copies = 0;
+    m.resize(100);
+    m.insert(counted_key("Front"), 8, 0);
+    m.erase(0);
+    m.erase(3);
+    m.move(15, 2);
+    m.move(2, 15);
+    m.swap(1, 12);
+
+    EXPECT_EQ(counted_key::copies, 0);
+    EXPECT_GT(counted_key::moves, 0);
+    EXPECT_EQ(m.size(), 20);
+    EXPECT_EQ(m.get_key(9).name, "Mid");
+}
+
+TEST_F(VectorMapTestManagement, Swap) {
+    n.swap(1, 4);
+    n.swap(2, 2);
+    EXPECT_EQ(values(n), std::vector<size_t>({0, 4, 2, 3, 1, 5}));
+    EXPECT_EQ(n.get_key(4), "Uno");
+
+    vmap a = {{"Uno", 1}};
+    const vmap::value_type* elements = n.data();
+    static_assert(noexcept(swap(a, n)));
+    swap(a, n);
+    EXPECT_EQ(a.data(), elements);
+    EXPECT_EQ(a.size(), 6);
+    EXPECT_EQ(n.get_key(0), "Uno");
+    a.swap(a);
+    EXPECT_EQ(a.size(), 6);
+
+    std::vector<vmap> maps = {{{"Dos", 2}, {"Dos", 2}}, {}, {{"Uno", 1}}};
+    std::ranges::sort(maps, {}, &vmap::size);
+    EXPECT_TRUE(maps[0].is_empty());
+    EXPECT_EQ(maps[1].get_key(0), "Uno");
+    EXPECT_EQ(maps[2].size(), 2);
+}
+
+TEST_F(VectorMapTestManagement, SetKeyStrongGuarantee) {
+    com::vectormap<fragile, size_t, 4, com::hash_index<fragile, fragile_hash>> m;
+    for (size_t i = 0; i < 4; ++i) {
+        m.push_back(fragile(i), i);
+    }
+    auto expect_unchanged = [&]() {
+        ASSERT_EQ(m.size(), 4);
+        for (size_t i = 0; i < 4; ++i) {
+            EXPECT_EQ(m[i].first.value, i);
+            EXPECT_EQ(m[i].second, i);
+            EXPECT_EQ(m.get_all_pos(fragile(i)), std::vector<size_t>({i}));
+        }
+        EXPECT_FALSE(m.contains(fragile(9)));
+    };
+
+    // The key copy throws before the element or the index are touched.
+    EXPECT_THROW(m.set_key_at(fragile(9, true), 1), std::runtime_error);
+    expect_unchanged();
+    EXPECT_THROW(m.set_at({fragile(9, true), 9}, 2), std::runtime_error);
+    expect_unchanged();
+
+    m.set_key_at(fragile(9), 1);
+    m.set_at({fragile(8), 8}, 2);
+    EXPECT_EQ(m.get_all_pos(fragile(9)), std::vector<size_t>({1}));
+    EXPECT_EQ(m.get_all_pos(fragile(8)), std::vector<size_t>({2}));
+    EXPECT_FALSE(m.contains(fragile(1)));
+    EXPECT_EQ(m.get_value_at(1), 1);
+    EXPECT_EQ(m.get_value_at(2), 8);
+}
+
+TEST_F(VectorMapTestManagement, CopyCleanup) {
+    using dmap = com::vectormap<std::string, countdown, 3>;
+    const long initial = countdown::alive;
+    {
+        const std::initializer_list<dmap::value_type> il = {{"Uno", countdown(1)}, {"Dos", countdown(2)}, {"Tres", countdown(3)}, {"Cuatro", countdown(4)}};
+        const long before = countdown::alive;
+
+        // The elements already copied are destroyed and the buffer is released (checked by the sanitizer builds).
+        countdown::copies_left = 2;
+        EXPECT_THROW(dmap m(il), std::runtime_error);
+        EXPECT_EQ(countdown::alive, before);
+
+        const dmap m(il);
+        countdown::copies_left = 3;
+        EXPECT_THROW(dmap copy(m), std::runtime_error);
+        EXPECT_EQ(countdown::alive, before + 4);
+
+        dmap target = {{"Cero", countdown(0)}};
+        countdown::copies_left = 1;
+        EXPECT_THROW(target = m, std::runtime_error);
+        EXPECT_TRUE(target.is_empty());
+        EXPECT_FALSE(target.contains("Cero"));
+        EXPECT_EQ(countdown::alive, before + 4);
+
+        target = m;
+        EXPECT_EQ(target.get_value_at(3).value, 4);
+    }
+    EXPECT_EQ(countdown::alive, initial);
+}
+
+TEST_F(VectorMapTestManagement, StrongGuarantee) {
+    using fmap = com::vectormap<std::string, fragile, 4>;
+    fmap m;
+    for (size_t i = 0; i < 4; ++i) {
+        m.push_back("Key", fragile(i));
+    }
+    auto expect_unchanged = [&](const auto& map, size_t size) {
+        ASSERT_EQ(map.size(), size);
+        for (size_t i = 0; i < size; ++i) {
+            EXPECT_EQ(map[i].second.value, i);
+        }
+    };
+
+    // Growing copies every element to the new buffer before destroying the old ones.
+    ASSERT_EQ(m.size(), m.capacity());
+    m[2].second = fragile(2, true);
+    const fmap::value_type* elements = m.data();
+    EXPECT_THROW(m.push_back("Key", fragile(4)), std::runtime_error);
+    EXPECT_THROW(m.insert({{"Key", fragile(4)}, {"Key", fragile(5)}}, 1), std::runtime_error);
+    EXPECT_THROW(m.resize(16), std::runtime_error);
+    EXPECT_EQ(m.data(), elements);
+    EXPECT_EQ(m.capacity(), 4);
+    expect_unchanged(m, 4);
+
+    // The new elements are built before and after the others are shifted.
+    m[2].second = fragile(2);
+    m.resize(16);
+    std::vector<fmap::value_type> batch = {{"New", fragile(10)}, {"New", fragile(11)}};
+    batch[1].second.poisoned = true;
+    EXPECT_THROW(m.insert(1, batch.begin(), batch.end()), std::runtime_error);
+    EXPECT_THROW(m.insert(4, batch.begin(), batch.end()), std::runtime_error);
+    fmap tail(batch.begin(), batch.begin() + 1);
+    tail.push_back("New", fragile(11));
+    tail[1].second.poisoned = true;
+    EXPECT_THROW(m.insert(std::move(tail), 0), std::runtime_error);
+    EXPECT_EQ(tail.size(), 2);
+    expect_unchanged(m, 4);
+
+    com::vectormap<std::string, fragile, 4, com::no_index, com::front_gap<>> d;
+    for (size_t i = 0; i < 4; ++i) {
+        d.push_back("Key", fragile(i));
+    }
+    EXPECT_THROW(d.insert(1, batch.begin(), batch.end()), std::runtime_error);
+    expect_unchanged(d, 4);
+    EXPECT_FALSE(d.contains("New"));
+
+    m.insert(2, batch.begin(), batch.begin() + 1);
+    EXPECT_EQ(m.size(), 5);
+    EXPECT_EQ(m[2].second.value, 10);
+}
+
+TEST_F(VectorMapTestManagement, ShiftStrongGuarantee) {
+    // The elements after pos cannot be shifted in place without risking a throw halfway.
+    com::vectormap<std::string, fragile, 16> m;
+    com::vectormap<std::string, fragile, 16, com::no_index, com::front_gap<>> d;
+    for (size_t i = 0; i < 10; ++i) {
+        m.push_back("Key", fragile(i));
+        d.push_back("Key", fragile(i));
+    }
+    ASSERT_LT(m.size(), m.capacity());
+    m[5].second.poisoned = true;
+    d[1].second.poisoned = true;
+
+    EXPECT_THROW(m.insert("New", fragile(10), 2), std::runtime_error);
+    EXPECT_THROW(m.emplace(7, "New", fragile(10)), std::runtime_error);
+    EXPECT_THROW(m.insert({{"New", fragile(10)}}, 1), std::runtime_error);
+    EXPECT_THROW(d.insert("New", fragile(10), 2), std::runtime_error);
+    EXPECT_THROW(d.push_front("New", fragile(10)), std::runtime_error);
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(m[i].second.value, i);
+        EXPECT_EQ(d[i].second.value, i);
+    }
+    EXPECT_FALSE(m.contains("New"));
+    EXPECT_FALSE(d.contains("New"));
+
+    m.push_back("Last", fragile(10));
+    m[5].second.poisoned = false;
+    m.insert("New", fragile(11), 2);
+    EXPECT_EQ(m[2].second.value, 11);
+    EXPECT_EQ(m[11].second.value, 10);
+    EXPECT_EQ(m.size(), 12);
+}
+
+TEST_F(VectorMapTestManagement, NothrowMove) {
+    static_assert(std::is_nothrow_move_constructible_v<vmap>);
+    static_assert(std::is_nothrow_move_assignable_v<vmap>);
+    static_assert(std::is_nothrow_default_constructible_v<vmap>);
+
+    // std::vector moves its vectormaps when it reallocates.
+    std::vector<vmap> maps(1, n);
+    const vmap::value_type* elements = maps[0].data();
+    for (size_t i = 0; i < 100; ++i) {
+        maps.emplace_back();
+    }
+    EXPECT_EQ(maps[0].data(), elements);
+}
+
+TEST_F(VectorMapTestManagement, TriviallyRelocatable) {
+    static_assert(com::is_trivially_relocatable<plain_key>::value);
+
+    pmap m;
+    for (int i = 0; i < 10; ++i) {
+        m.push_back(plain_key(i), i);
+    }
+    m.insert(plain_key(20), 20, 5);
+    m.erase(0);
+    m.move(8, 1);
+    m.resize(50);
+
+    EXPECT_EQ(values(m), std::vector<size_t>({1, 8, 2, 3, 4, 20, 5, 6, 7, 9}));
+    EXPECT_EQ(m.get_all_pos(plain_key(20)), std::vector<pmap::size_type>({5}));
+}
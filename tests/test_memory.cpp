@@ -0,0 +1,336 @@
+#include "vectormap.hpp"
+#include "indexed_vectormap.hpp"
+#include "gtest/gtest.h"
+
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+using vmap = com::vectormap<std::string, size_t, 3>;
+using gmap = com::vectormap<std::string, size_t, 3, com::no_index, com::geometric_growth<2>>;
+using hmap = com::vectormap<std::string, size_t, 3, com::no_index, com::hybrid_growth<6, 3, 2>>;
+using pmap = com::pmr::vectormap<std::pmr::string, size_t, 3>;
+
+// Memory resource that counts the bytes it is currently lending.
+class counting_resource : public std::pmr::memory_resource {
+    public:
+        size_t in_use = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t align) override { in_use += bytes; return std::pmr::new_delete_resource()->allocate(bytes, align); }
+        void do_deallocate(void* p, size_t bytes, size_t align) override { in_use -= bytes; std::pmr::new_delete_resource()->deallocate(p, bytes, align); }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Stateful allocator that propagates on copy, move and swap.
+template<class T>
+struct tagged_allocator : std::allocator<T> {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    int tag = 0;
+
+    tagged_allocator(int t = 0) : tag(t) {}
+    template<class U> tagged_allocator(const tagged_allocator<U>& other) : tag(other.tag) {}
+    template<class U> struct rebind { using other = tagged_allocator<U>; };
+    bool operator==(const tagged_allocator& other) const { return tag == other.tag; }
+};
+
+template<size_t inline_>
+using smap = com::small_vectormap<std::string, size_t, inline_, 3, com::no_index, com::delta_growth, std::pmr::polymorphic_allocator<std::pair<const std::string, size_t>>>;
+
+using tmap = com::vectormap<std::string, size_t, 3, com::no_index, com::delta_growth, tagged_allocator<std::pair<const std::string, size_t>>>;
+
+class VectorMapTestMemory : public ::testing::Test {
+    protected:
+        template<class map_>
+        std::vector<size_t> capacities(map_& map, size_t n) {
+            std::vector<size_t> out;
+            for (size_t i = 0; i < n; ++i) {
+                map.push_back(std::to_string(i), i);
+                if (out.empty() || (out.back() != map.capacity())) {
+                    out.push_back(map.capacity());
+                }
+            }
+            return out;
+        }
+};
+
+TEST_F(VectorMapTestMemory, DeltaGrowth) {
+    vmap m;
+    EXPECT_EQ(capacities(m, 10), std::vector<size_t>({3, 6, 9, 12}));
+}
+
+TEST_F(VectorMapTestMemory, GeometricGrowth) {
+    gmap m;
+    EXPECT_EQ(capacities(m, 50), std::vector<size_t>({3, 6, 12, 24, 48, 96}));
+    EXPECT_EQ(m.size(), 50);
+    EXPECT_EQ(m.get_key(49), "49");
+}
+
+TEST_F(VectorMapTestMemory, HybridGrowth) {
+    hmap m;
+    EXPECT_EQ(capacities(m, 30), std::vector<size_t>({3, 6, 9, 13, 19, 28, 42}));
+}
+
+TEST_F(VectorMapTestMemory, GrowthPolicies) {
+    EXPECT_EQ(com::delta_growth::grow(100, 101, 100), 200);
+    EXPECT_EQ((com::geometric_growth<3, 2>::grow(100, 101, 10)), 150);
+    EXPECT_EQ(com::geometric_growth<2>::grow(100, 300, 10), 300);
+    EXPECT_EQ(com::geometric_growth<2>::grow(0, 1, 10), 10);
+    EXPECT_EQ(com::hybrid_growth<1000>::grow(100, 101, 100), 200);
+    EXPECT_EQ(com::hybrid_growth<1000>::grow(1000, 1001, 100), 2000);
+}
+
+TEST_F(VectorMapTestMemory, Footprint) {
+    static_assert(sizeof(com::vectormap<std::string, std::string>) == 3 * sizeof(void*));
+    static_assert(sizeof(com::vectormap<int, int, 100, com::no_index, com::auto_shrink<>>) == 3 * sizeof(void*));
+
+    vmap m = {{"Uno", 1}};
+    EXPECT_EQ(m.get_key_at(1), "");
+    EXPECT_EQ(m.get_value_at(1), 0);
+    const vmap empty;
+    EXPECT_EQ(&empty.get_value_at(0), &std::as_const(m).get_value_at(1));
+    static_assert(std::is_same_v<decltype(std::as_const(m).get_value_at(1)), const size_t&>);
+
+    // The mutable accessors stay writable, and the sentinel is untouched by a write out of range.
+    m.get_value(0) = 10;
+    EXPECT_EQ(m.get_value_at(0), 10);
+    m.get_value_at(1) = 20;
+    EXPECT_EQ(m.get_value_at(1), 0);
+    EXPECT_EQ(std::as_const(m).get_value_at(1), 0);
+}
+
+TEST_F(VectorMapTestMemory, AutoShrink) {
+    using amap = com::vectormap<std::string, size_t, 3, com::no_index, com::auto_shrink<1, 4>>;
+    static_assert(com::auto_shrink<1, 4>::shrink(100, 25, 10) == 100);
+    static_assert(com::auto_shrink<1, 4>::shrink(100, 24, 10) == 48);
+    static_assert(com::auto_shrink<1, 4, com::delta_growth>::shrink(100, 2, 10) == 10);
+    static_assert(com::auto_shrink<1, 4>::shrink(100, 0, 10) == 0);
+
+    amap m;
+    EXPECT_EQ(capacities(m, 100), std::vector<size_t>({3, 6, 12, 24, 48, 96, 192}));
+    std::vector<size_t> shrunk;
+    while (m.size() > 1) {
+        m.erase_at(0);
+        if (shrunk.empty() || (shrunk.back() != m.capacity())) {
+            shrunk.push_back(m.capacity());
+        }
+        ASSERT_GE(4 * m.size(), m.capacity());
+    }
+    EXPECT_EQ(shrunk, std::vector<size_t>({192, 94, 46, 22, 10, 4}));
+    EXPECT_EQ(m.get_key(0), "99");
+
+    for (size_t i = 0; i < 40; ++i) {
+        m.push_back(std::to_string(i), i);
+    }
+    EXPECT_EQ(m.erase_if([](const auto& elem) { return elem.second > 2; }), 38);
+    EXPECT_EQ(m.capacity(), 6);
+    EXPECT_EQ(m.get_all_values("1"), std::vector<size_t>({1}));
+
+    m.clear();
+    EXPECT_EQ(m.capacity(), 0);
+    EXPECT_EQ(m.data(), nullptr);
+    m.push_back("Uno", 1);
+    EXPECT_EQ(m.get_value_at(0), 1);
+
+    // The default policies keep the memory.
+    vmap n;
+    capacities(n, 10);
+    n.clear();
+    EXPECT_EQ(n.capacity(), 12);
+}
+
+TEST_F(VectorMapTestMemory, Allocator) {
+    tmap a(tagged_allocator<tmap::value_type>(1));
+    tmap b(tagged_allocator<tmap::value_type>(2));
+    a.push_back("Uno", 1);
+    b.push_back("Dos", 2);
+
+    tmap c = a;
+    EXPECT_EQ(c.get_allocator().tag, 1);
+    c = b;
+    EXPECT_EQ(c.get_allocator().tag, 2);
+    EXPECT_EQ(c.get_key_at(0), "Dos");
+
+    swap(a, b);
+    EXPECT_EQ(a.get_allocator().tag, 2);
+    EXPECT_EQ(a.get_key_at(0), "Dos");
+
+    tmap d(std::move(b));
+    EXPECT_EQ(d.get_allocator().tag, 1);
+    EXPECT_EQ(d.get_key_at(0), "Uno");
+}
+
+TEST_F(VectorMapTestMemory, Arena) {
+    std::byte buffer[16384];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    pmap m(&arena);
+    for (size_t i = 0; i < 20; ++i) {
+        m.push_back(std::pmr::string("Key"), i);
+    }
+    EXPECT_EQ(m.get_allocator().resource(), &arena);
+    EXPECT_EQ(m.get_key_at(0).get_allocator().resource(), &arena);
+    EXPECT_EQ(m.count("Key"), 20);
+
+    com::pmr::indexed_vectormap<std::pmr::string, size_t, 3> im(&arena);
+    im.push_back(std::pmr::string("Key"), 1);
+    EXPECT_EQ(im.get_all_pos("Key"), std::vector<size_t>({0}));
+}
+
+TEST_F(VectorMapTestMemory, PmrPropagation) {
+    counting_resource first;
+    counting_resource second;
+    pmap a(&first);
+    a.push_back(std::pmr::string("A key long enough to be allocated"), 1);
+
+    // Polymorphic allocators do not propagate: copies use the default resource, moves keep theirs.
+    pmap copy = a;
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+
+    pmap b(&second);
+    b = std::move(a);
+    EXPECT_EQ(b.get_allocator().resource(), &second);
+    EXPECT_EQ(b.get_key_at(0).get_allocator().resource(), &second);
+    EXPECT_EQ(b.get_key_at(0), "A key long enough to be allocated");
+    EXPECT_EQ(a.size(), 0);
+
+    pmap c(std::move(b), &first);
+    EXPECT_EQ(c.get_value_at(0), 1);
+    EXPECT_EQ(b.size(), 0);
+
+    a.clear();
+    a.shrink();
+    b.shrink();
+    EXPECT_GT(first.in_use, 0);
+    c.clear();
+    c.shrink();
+    EXPECT_EQ(first.in_use, 0);
+}
+
+TEST_F(VectorMapTestMemory, SmallVectormap) {
+    static_assert(sizeof(com::vectormap<int, int>) == sizeof(com::vectormap<int, int, 100, com::no_index, com::delta_growth, std::allocator<std::pair<const int, int>>, 0>));
+    static_assert(sizeof(com::small_vectormap<int, int, 8>) >= sizeof(com::vectormap<int, int>) + 8 * sizeof(std::pair<const int, int>));
+
+    counting_resource heap;
+    smap<4> m(&heap);
+    for (size_t i = 0; i < 4; ++i) {
+        m.push_back(std::to_string(i), i);
+    }
+    EXPECT_EQ(heap.in_use, 0);
+    EXPECT_EQ(m.capacity(), 4);
+
+    m.push_back("4", 4);
+    EXPECT_GT(heap.in_use, 0);
+    EXPECT_EQ(m.capacity(), 6);
+    EXPECT_EQ(m.get_all_pos("4"), std::vector<size_t>({4}));
+
+    m.erase_at(4);
+    EXPECT_TRUE(m.shrink());
+    EXPECT_EQ(heap.in_use, 0);
+    EXPECT_EQ(m.capacity(), 4);
+    EXPECT_EQ(m.get_value("3"), std::vector<size_t>({3}));
+
+    smap<4> n({{"Uno", 1}, {"Dos", 2}}, &heap);
+    EXPECT_EQ(heap.in_use, 0);
+}
+
+TEST_F(VectorMapTestMemory, SmallVectormapReserve) {
+    com::small_vectormap<int, int, 4> m;
+    m.push_back(1, 1);
+    const auto* inline_data = m.data();
+    auto in_object = [&]() {
+        const auto* object = reinterpret_cast<const std::byte*>(&m);
+        const auto* data = reinterpret_cast<const std::byte*>(m.data());
+        return (data >= object) && (data < object + sizeof(m));
+    };
+    ASSERT_TRUE(in_object());
+
+    EXPECT_TRUE(m.reserve(3));
+    EXPECT_TRUE(m.reserve(4));
+    EXPECT_EQ(m.data(), inline_data);
+    EXPECT_EQ(m.capacity(), 4);
+    EXPECT_TRUE(in_object());
+
+    // Past the inline buffer the elements go to the heap, and back once they fit again.
+    EXPECT_TRUE(m.reserve(5));
+    EXPECT_FALSE(in_object());
+    EXPECT_TRUE(m.reserve(2));
+    EXPECT_TRUE(in_object());
+    EXPECT_EQ(m.get_value_at(0), 1);
+}
+
+TEST_F(VectorMapTestMemory, SmallVectormapMoves) {
+    smap<4> a = {{"Uno", 1}, {"Dos", 2}};
+    smap<4> b = {{"Tres", 3}, {"Cuatro", 4}, {"Cinco", 5}, {"Seis", 6}, {"Siete", 7}};
+
+    smap<4> c = a;
+    EXPECT_EQ(c.get_key_at(1), "Dos");
+
+    smap<4> d(std::move(a));
+    EXPECT_EQ(a.size(), 0);
+    EXPECT_EQ(d.size(), 2);
+    EXPECT_EQ(d.get_key_at(1), "Dos");
+    a.push_back("Ocho", 8);
+    EXPECT_EQ(a.get_key_at(0), "Ocho");
+
+    swap(d, b);
+    EXPECT_EQ(d.size(), 5);
+    EXPECT_EQ(d.get_key_at(4), "Siete");
+    EXPECT_EQ(b.size(), 2);
+    EXPECT_EQ(b.get_key_at(0), "Uno");
+
+    b = std::move(d);
+    EXPECT_EQ(b.size(), 5);
+    EXPECT_EQ(b.get_key_at(0), "Tres");
+    c = std::move(a);
+    EXPECT_EQ(c.size(), 1);
+    EXPECT_EQ(c.get_key_at(0), "Ocho");
+}
+
+TEST_F(VectorMapTestMemory, Stats) {
+    static_assert(sizeof(com::instrumented_vectormap<int, int>) > sizeof(com::vectormap<int, int>));
+
+    com::instrumented_vectormap<std::string, size_t, 3> m = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}};
+    EXPECT_EQ(m.stats().allocations, 1);
+    EXPECT_EQ(m.stats().bytes_allocated, 3 * sizeof(vmap::value_type));
+    EXPECT_EQ(m.stats().peak_size, 3);
+
+    m.push_back("Tres", 3);
+    EXPECT_EQ(m.stats().allocations, 2);
+    EXPECT_EQ(m.stats().relocations, 3);
+
+    // The new element is built aside and relocated after the four shifted ones.
+    m.push_front("Dos", 4);
+    EXPECT_EQ(m.stats().relocations, 8);
+    EXPECT_EQ(m.stats().peak_size, 5);
+
+    m.reset_stats();
+    EXPECT_EQ(m.get_all("Dos").size(), 2);
+    EXPECT_EQ(m.stats().lookups, 1);
+    EXPECT_EQ(m.stats().compared, 5);
+    m.get("Dos");
+    EXPECT_EQ(m.stats().lookups, 2);
+    EXPECT_EQ(m.stats().compared, 6);
+
+    m.erase_at(0);
+    m.shrink();
+    EXPECT_EQ(m.stats().resizes, 1);
+    EXPECT_EQ(m.stats().relocations, 8);
+
+    com::instrumented_vectormap<std::string, size_t, 3> copy = m;
+    EXPECT_EQ(copy.stats().lookups, 0);
+    EXPECT_EQ(copy.stats().peak_size, 4);
+
+    // The counters follow the contents they describe.
+    com::instrumented_vectormap<std::string, size_t, 3> other;
+    swap(m, other);
+    EXPECT_EQ(other.stats().lookups, 2);
+    EXPECT_EQ(other.stats().resizes, 1);
+    EXPECT_EQ(m.stats().lookups, 0);
+    EXPECT_EQ(m.stats().resizes, 0);
+}
@@ -0,0 +1,161 @@
+#include "indexed_vectormap.hpp"
+#include "vectormap_view.hpp"
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using vmap = com::vectormap<uint32_t, double, 3>;
+using imap = com::indexed_vectormap<uint32_t, double, 3>;
+using view = com::vectormap_view<uint32_t, double>;
+
+static_assert(vmap::serializable);
+static_assert(!com::vectormap<std::string, size_t>::serializable);
+
+class VectorMapTestSerialization : public ::testing::Test {
+    protected:
+        vmap m = {{0, 0.5}, {1, 1.5}, {2, 2.5}, {3, 3.5}, {2, 4.5}, {5, 5.5}, {6, 6.5}, {2, 7.5}, {8, 8.5}};
+
+        std::vector<std::byte> blob() const {
+            std::vector<std::byte> out;
+            m.serialize([&out](const std::byte* data, size_t size) { out.insert(out.end(), data, data + size); });
+            return out;
+        }
+};
+
+TEST_F(VectorMapTestSerialization, RoundTrip) {
+    std::vector<std::byte> b = blob();
+    EXPECT_EQ(b.size(), com::serialized_header::header_size + m.size() * sizeof(vmap::value_type));
+
+    vmap n;
+    ASSERT_TRUE(n.deserialize(b));
+    ASSERT_EQ(n.size(), m.size());
+    for (vmap::size_type i = 0; i < m.size(); ++i) {
+        EXPECT_EQ(n[i], m[i]);
+    }
+    EXPECT_EQ(n.get_all_pos(2), std::vector<vmap::size_type>({2, 4, 7}));
+
+    imap p = {{9, 9.5}};
+    ASSERT_TRUE(p.deserialize(b));
+    EXPECT_EQ(p.size(), 9);
+    EXPECT_EQ(p.get_all_pos(2), std::vector<imap::size_type>({2, 4, 7}));
+    EXPECT_FALSE(p.contains(9));
+
+    std::ostringstream out;
+    m.serialize(out);
+    std::string s = out.str();
+    ASSERT_EQ(s.size(), b.size());
+    EXPECT_EQ(std::memcmp(s.data(), b.data(), b.size()), 0);
+
+    vmap empty;
+    std::vector<std::byte> e;
+    empty.serialize([&e](const std::byte* data, size_t size) { e.insert(e.end(), data, data + size); });
+    ASSERT_TRUE(n.deserialize(e));
+    EXPECT_TRUE(n.is_empty());
+}
+
+TEST_F(VectorMapTestSerialization, InvalidBlob) {
+    std::vector<std::byte> b = blob();
+    vmap n = {{9, 9.5}};
+
+    com::vectormap<uint32_t, float> other;
+    EXPECT_FALSE(other.deserialize(b));
+    EXPECT_FALSE(n.deserialize(std::span<const std::byte>(b).first(com::serialized_header::header_size - 1)));
+    EXPECT_FALSE(n.deserialize(std::span<const std::byte>(b).first(b.size() - 1)));
+
+    std::vector<std::byte> bad = b;
+    bad[0] = std::byte{0};
+    EXPECT_FALSE(n.deserialize(bad));
+    EXPECT_FALSE(view(bad).is_valid());
+
+    ASSERT_EQ(n.size(), 1);
+    EXPECT_EQ(n.get_value_at(0), 9.5);
+}
+
+TEST_F(VectorMapTestSerialization, View) {
+    std::vector<std::byte> b = blob();
+    view v(b);
+
+    ASSERT_TRUE(v.is_valid());
+    ASSERT_EQ(v.size(), 9);
+    EXPECT_EQ(static_cast<const void*>(v.data()), static_cast<const void*>(b.data() + com::serialized_header::header_size));
+    EXPECT_EQ(v.get_all_pos(2), std::vector<view::size_type>({2, 4, 7}));
+    EXPECT_EQ(v.get_value(2, 2, 2), std::vector<double>({4.5, 7.5}));
+    EXPECT_EQ(v.get_all_values(5), std::vector<double>({5.5}));
+    EXPECT_EQ(v.find_nth(2, 3)->second, 7.5);
+    EXPECT_EQ(v.find(4), v.end());
+    EXPECT_EQ(v.count(2), 3);
+    EXPECT_TRUE(v.contains(8));
+    EXPECT_EQ(v.get_key_at(3), 3);
+    EXPECT_EQ(v.get_value_at(20), 0.0);
+    EXPECT_EQ(v.get_at(20), v.end());
+
+    std::vector<view::iterator_pos> g = v.get(2, 2);
+    ASSERT_EQ(g.size(), 1);
+    EXPECT_EQ(g.at(0).first->second, 4.5);
+    EXPECT_EQ(g.at(0).second, 4);
+
+    size_t i = 0;
+    for (const auto& [key, value] : v) {
+        EXPECT_EQ(key, m[i].first);
+        EXPECT_EQ(value, m[i].second);
+        ++i;
+    }
+    EXPECT_EQ(i, 9);
+    EXPECT_EQ(v.rbegin()->first, 8);
+
+    view empty;
+    EXPECT_FALSE(empty.is_valid());
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST_F(VectorMapTestSerialization, LargeView) {
+    com::vectormap<uint64_t, std::array<char, 24>> p;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        p.push_back(i % 10, {static_cast<char>(i)});
+    }
+
+    std::vector<std::byte> b;
+    p.serialize([&b](const std::byte* data, size_t size) { b.insert(b.end(), data, data + size); });
+    com::vectormap_view<uint64_t, std::array<char, 24>> v(b);
+
+    ASSERT_TRUE(v.is_valid());
+    EXPECT_EQ(v.count(3), 100);
+    EXPECT_EQ(v.get_pos(7, 5).at(0), 47);
+    EXPECT_EQ(v.get_value_at(47)[0], 47);
+}
+
+#if defined(__unix__)
+TEST_F(VectorMapTestSerialization, MappedFile) {
+    char path[] = "/tmp/vectormap_testXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+
+    std::vector<std::byte> b = blob();
+    ASSERT_EQ(write(fd, b.data(), b.size()), static_cast<ssize_t>(b.size()));
+
+    void* mapped = mmap(nullptr, b.size(), PROT_READ, MAP_PRIVATE, fd, 0);
+    ASSERT_NE(mapped, MAP_FAILED);
+    {
+        view v(std::span<const std::byte>(static_cast<const std::byte*>(mapped), b.size()));
+        ASSERT_TRUE(v.is_valid());
+        EXPECT_EQ(v.get_all_pos(2), std::vector<view::size_type>({2, 4, 7}));
+        EXPECT_EQ(v.get_value(8).at(0), 8.5);
+    }
+
+    munmap(mapped, b.size());
+    close(fd);
+    std::remove(path);
+}
+#endif
@@ -0,0 +1,114 @@
+#include "vectormap.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+enum class color : uint8_t { red, green, blue };
+
+template<class key_, class value_>
+struct layout_ {
+    key_ key;
+    value_ value;
+};
+
+class VectorMapTestSimd : public ::testing::Test {
+    protected:
+        template<class key_, size_t stride_>
+        std::vector<size_t> scan(const std::byte* base, size_t n, key_ key) {
+            std::vector<size_t> out;
+            com::simd::for_each_match<key_, stride_>(base, n, key, [&](size_t i) { out.push_back(i); return true; });
+            return out;
+        }
+
+        template<class key_, class value_>
+        void check_layout() {
+            std::mt19937 gen(42);
+            std::vector<layout_<key_, value_>> data(1000);
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < data.size(); ++i) {
+                data[i].key = static_cast<key_>(gen() % 4);
+                if constexpr (std::is_arithmetic_v<value_>) {
+                    data[i].value = static_cast<value_>(3);
+                }
+                else {
+                    data[i].value = {3, 3};
+                }
+                if (data[i].key == static_cast<key_>(3)) {
+                    expected.push_back(i);
+                }
+            }
+
+            for (size_t n : {size_t(0), size_t(1), size_t(7), size_t(33), data.size()}) {
+                std::vector<size_t> prefix;
+                for (size_t i : expected) {
+                    if (i < n) {
+                        prefix.push_back(i);
+                    }
+                }
+                EXPECT_EQ((scan<key_, sizeof(layout_<key_, value_>)>(reinterpret_cast<const std::byte*>(data.data()), n, static_cast<key_>(3))), prefix);
+            }
+        }
+};
+
+TEST_F(VectorMapTestSimd, Contiguous) {
+    std::vector<uint32_t> keys(100, 1);
+    keys[0] = keys[9] = keys[31] = keys[99] = 5;
+
+    std::vector<size_t> out;
+    com::simd::for_each_match(keys.data(), keys.size(), uint32_t(5), [&](size_t i) { out.push_back(i); return true; });
+    EXPECT_EQ(out, std::vector<size_t>({0, 9, 31, 99}));
+
+    out.clear();
+    com::simd::for_each_match(keys.data(), keys.size(), uint32_t(5), [&](size_t i) { out.push_back(i); return out.size() < 2; });
+    EXPECT_EQ(out, std::vector<size_t>({0, 9}));
+}
+
+TEST_F(VectorMapTestSimd, Layouts) {
+    check_layout<uint8_t, uint8_t>();
+    check_layout<int16_t, int16_t>();
+    check_layout<int32_t, int32_t>();
+    check_layout<int32_t, char>();
+    check_layout<int64_t, int64_t>();
+    check_layout<uint64_t, double>();
+    check_layout<int32_t, int64_t>();
+    check_layout<color, uint8_t>();
+    check_layout<uint16_t, layout_<char, char>>();
+}
+
+TEST_F(VectorMapTestSimd, IntegralKeys) {
+    com::vectormap<int, int, 3> m;
+    for (int i = 0; i < 50; ++i) {
+        m.push_back(i % 5, i);
+    }
+
+    EXPECT_EQ(m.get_all_pos(2), std::vector<size_t>({2, 7, 12, 17, 22, 27, 32, 37, 42, 47}));
+    EXPECT_EQ(m.get_value(3, 2, 2), std::vector<int>({8, 13}));
+    EXPECT_EQ(m.count(4), 10);
+    EXPECT_EQ(m.find(9), m.end());
+    EXPECT_EQ(m.get_at(5)->second, 5);
+    EXPECT_EQ(m.get_value_at(6), 6);
+    EXPECT_EQ(m.get_key_at(6), 1);
+    EXPECT_EQ(m[7].second, 7);
+
+    m.erase(2);
+    EXPECT_EQ(m.size(), 49);
+    EXPECT_EQ(m.get_all_pos(2).front(), 6);
+    m.erase_at(0);
+    EXPECT_EQ(m.get_key_at(0), 1);
+    m.set_value(100, 1);
+    EXPECT_EQ(m.get_value_at(0), 100);
+    m.set_value_at(200, 0);
+    EXPECT_EQ(m.get_value_at(0), 200);
+}
+
+TEST_F(VectorMapTestSimd, EnumKeys) {
+    com::vectormap<color, size_t, 3> m = {{color::red, 0}, {color::blue, 1}, {color::green, 2}, {color::blue, 3}};
+
+    EXPECT_EQ(m.get_all_values(color::blue), std::vector<size_t>({1, 3}));
+    EXPECT_EQ(m.get(2)->first, color::green);
+    m.erase(color::blue);
+    EXPECT_EQ(m.get_all_pos(color::blue), std::vector<size_t>({2}));
+}
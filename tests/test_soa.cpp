@@ -0,0 +1,205 @@
+#include "soa_vectormap.hpp"
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using vmap = com::vectormap<std::string, size_t, 3>;
+using smap = com::soa_vectormap<std::string, size_t, 3>;
+
+// The proxy iterators traverse as C++20 random access iterators, and only claim an input iterator to legacy algorithms.
+static_assert(std::random_access_iterator<smap::iterator>);
+static_assert(std::is_same_v<std::iterator_traits<smap::iterator>::iterator_category, std::input_iterator_tag>);
+
+// Value whose copies throw once poisoned.
+struct fragile {
+    size_t value = 0;
+    bool poisoned = false;
+
+    fragile() = default;
+    fragile(size_t v, bool p = false) : value(v), poisoned(p) {}
+    fragile(const fragile& other) : value(other.value), poisoned(other.poisoned) { if (poisoned) throw std::runtime_error("copy"); }
+    fragile& operator=(const fragile&) = default;
+};
+
+class VectorMapTestSoa : public ::testing::Test {
+    protected:
+        vmap n = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+        smap m = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+
+        void expect_same_elements() {
+            ASSERT_EQ(m.size(), n.size());
+            for (vmap::size_type i = 0; i < n.size(); ++i) {
+                EXPECT_EQ(m[i].first, n[i].first);
+                EXPECT_EQ(m[i].second, n[i].second);
+            }
+        }
+};
+
+TEST_F(VectorMapTestSoa, Access) {
+    EXPECT_EQ(m.get(5)->first, "Cinco");
+    EXPECT_EQ(m.get_value(5), 5);
+    EXPECT_EQ(m.get_key(3), "Tres");
+    EXPECT_EQ(m.get_all_pos("Dos"), n.get_all_pos("Dos"));
+    EXPECT_EQ(m.get_value("Dos", 2, 2), n.get_value("Dos", 2, 2));
+
+    // The key lookups are const, as in vectormap.
+    const smap& c = m;
+    EXPECT_EQ(c.get_pos("Dos", 2), n.get_pos("Dos", 2));
+    EXPECT_EQ(c.get_all_pos("Dos"), n.get_all_pos("Dos"));
+    EXPECT_EQ(c.get_value("Dos", 3), n.get_value("Dos", 3));
+    EXPECT_EQ(c.get_all_values("Dos"), n.get_all_values("Dos"));
+    EXPECT_EQ(m.get_all_values("Dos"), std::vector<size_t>({2, 4, 7}));
+    EXPECT_EQ(m.find_nth("Dos", 3)->second, 7);
+    EXPECT_EQ(m.find("Nueve"), m.end());
+    EXPECT_EQ(m.count("Dos"), 3);
+    EXPECT_TRUE(m.contains("Ocho"));
+
+    std::vector<smap::iterator_pos> v = m.get("Dos", 2);
+    ASSERT_EQ(v.size(), 1);
+    EXPECT_EQ(v.at(0).first->second, 4);
+    EXPECT_EQ(v.at(0).second, 4);
+
+    // Out of range, the setters do nothing.
+    m.set_value_at(20, m.size());
+    m.set_key_at("Veinte", m.size());
+    EXPECT_EQ(m.size(), 9);
+    EXPECT_FALSE(m.contains("Veinte"));
+    EXPECT_EQ(std::as_const(m).get_value_at(m.size()), 0);
+}
+
+TEST_F(VectorMapTestSoa, Iterators) {
+    size_t i = 0;
+    for (auto [key, value] : m) {
+        EXPECT_EQ(key, n[i].first);
+        value += 10;
+        ++i;
+    }
+    EXPECT_EQ(i, 9);
+    EXPECT_EQ(m.get_value(0), 10);
+
+    smap::const_iterator it = m.end();
+    EXPECT_EQ(it - m.begin(), 9);
+    EXPECT_EQ((--it)->first, "Ocho");
+    EXPECT_EQ(m.rbegin()->first, "Ocho");
+    EXPECT_EQ(m.begin()[2].first, "Dos");
+    EXPECT_EQ((3 + m.begin())->first, "Tres");
+    EXPECT_EQ(3 + m.cbegin(), m.cbegin() + 3);
+
+    size_t sum = 0;
+    for (size_t value : m.values()) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 126);
+    EXPECT_EQ(m.keys()[1], "Uno");
+}
+
+TEST_F(VectorMapTestSoa, Modification) {
+    n.insert({"Dos", 9}, 1);
+    m.insert({"Dos", 9}, 1);
+    n.push_front({{"Tres", 10}, {"Dos", 11}});
+    m.push_front({{"Tres", 10}, {"Dos", 11}});
+    n.push_back("Diez", 12);
+    m.push_back("Diez", 12);
+    m.emplace_back("Once", 13);
+    n.emplace_back("Once", 13);
+    expect_same_elements();
+
+    // Out of range insertions fail without touching the storage.
+    EXPECT_EQ(m.emplace(m.size() + 1, "Doce", 14), m.end());
+    EXPECT_EQ(m.insert({{"Doce", 14}}, m.size() + 1), m.end());
+    expect_same_elements();
+
+    n.set_value(20, "Dos", 2);
+    m.set_value(20, "Dos", 2);
+    n.set_key("Veinte", 3);
+    m.set_key("Veinte", 3);
+    n.set({"Uno", 21}, 0);
+    m.set({"Uno", 21}, 0);
+    expect_same_elements();
+
+    n.erase(4);
+    m.erase(4);
+    n.erase("Tres");
+    m.erase("Tres");
+    n.erase_all("Dos");
+    m.erase_all("Dos");
+    expect_same_elements();
+
+    n.erase({0, 3});
+    m.erase({3, 0});
+    expect_same_elements();
+
+    n.push_back(vmap(n));
+    m.push_back(smap(m));
+    EXPECT_EQ(m.erase_if([](smap::const_reference elem) { return elem.second > 10; }), 6);
+    n.erase_if([](const vmap::value_type& elem) { return elem.second > 10; });
+    expect_same_elements();
+
+    n.move(0, 5);
+    m.move(0, 5);
+    n.move(6, 1);
+    m.move(6, 1);
+    n.swap(2, 4);
+    m.swap(2, 4);
+    expect_same_elements();
+}
+
+TEST_F(VectorMapTestSoa, CopyAndMove) {
+    smap p = m;
+    m.clear();
+    EXPECT_EQ(m.size(), 0);
+    EXPECT_EQ(p.get_all_pos("Dos"), std::vector<smap::size_type>({2, 4, 7}));
+
+    smap q = std::move(p);
+    EXPECT_EQ(p.size(), 0);
+    EXPECT_EQ(q.size(), 9);
+
+    m = q;
+    expect_same_elements();
+    EXPECT_TRUE(m.reserve(100));
+    EXPECT_GE(m.capacity(), 100);
+    EXPECT_TRUE(m.shrink());
+    EXPECT_EQ(m.capacity(), 9);
+    expect_same_elements();
+}
+
+TEST_F(VectorMapTestSoa, IntegralKeys) {
+    com::soa_vectormap<uint64_t, std::array<char, 200>> p;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        p.push_back(i % 10, {static_cast<char>(i)});
+    }
+
+    EXPECT_EQ(p.count(3), 100);
+    EXPECT_EQ(p.get_pos(7, 5).at(0), 47);
+    EXPECT_EQ(p.get_value_at(47)[0], 47);
+    p.erase(7);
+    EXPECT_EQ(p.get_pos(7).at(0), 16);
+}
+
+TEST_F(VectorMapTestSoa, InsertThrows) {
+    // A copy that throws leaves the map as it was: the elements built are destroyed and the gap closed.
+    using fmap = com::soa_vectormap<std::string, fragile, 3>;
+    fmap f = {{"Cero", fragile(0)}, {"Uno", fragile(1)}};
+    EXPECT_THROW(f.insert({{"Dos", fragile(2)}, {"Tres", fragile(3, true)}}, 1), std::runtime_error);
+    EXPECT_THROW(f.insert({{"Dos", fragile(2)}, {"Tres", fragile(3, true)}, {"Cuatro", fragile(4)}, {"Cinco", fragile(5)}}, 0), std::runtime_error);
+    ASSERT_EQ(f.size(), 2);
+    EXPECT_EQ(f.get_key(0), "Cero");
+    EXPECT_EQ(f.get_value(1).value, 1);
+    EXPECT_FALSE(f.contains("Dos"));
+
+    fmap g = f;
+    g.set_value_at(fragile(1, true), 1);
+    EXPECT_THROW(f.insert(g, 1), std::runtime_error);
+    EXPECT_THROW(fmap copy(g), std::runtime_error);
+    ASSERT_EQ(f.size(), 2);
+    EXPECT_EQ(f.get_key(1), "Uno");
+
+    f.insert({{"Dos", fragile(2)}}, 1);
+    EXPECT_EQ(f.get_key(1), "Dos");
+    EXPECT_EQ(f.get_value(2).value, 1);
+}
@@ -0,0 +1,81 @@
+#include "static_vectormap.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+using vmap = com::vectormap<std::string_view, size_t, 3>;
+using smap = com::static_vectormap<std::string_view, size_t, 12>;
+
+constexpr smap table({{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}});
+
+struct unhashed {
+    constexpr size_t operator()(int) const = delete;
+};
+
+// The lookups run at compile time, both through the hash table and through the scan.
+static_assert(table.size() == 9);
+static_assert(table.capacity() == 12);
+static_assert(table.find("Tres")->second == 3);
+static_assert(table.find_nth("Dos", 3)->second == 7);
+static_assert(table.find("Nueve") == table.end());
+static_assert(table.count("Dos") == 3);
+static_assert(table.contains("Ocho") && !table.contains("Nueve"));
+static_assert(table.get_value("Dos", 2).at(0) == 4);
+static_assert(table.get_all_pos("Dos").size() == 3);
+static_assert(table.get_key(5) == "Cinco");
+static_assert(com::static_vectormap<int, int, 4, unhashed>({{1, 10}, {2, 20}, {1, 30}}).get_all_values(1) == std::vector<int>({10, 30}));
+static_assert(!com::static_vectormap<int, int, 4, unhashed>::hashed);
+static_assert(com::static_vectormap<int, int, 0>().is_empty());
+
+TEST(VectorMapTestStatic, Access) {
+    vmap n = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+
+    ASSERT_EQ(table.size(), n.size());
+    size_t i = 0;
+    for (const auto& elem : table) {
+        EXPECT_EQ(elem.first, n[i].first);
+        EXPECT_EQ(elem.second, n[i].second);
+        ++i;
+    }
+    for (std::string_view key : {"Cero"sv, "Dos"sv, "Ocho"sv, "Nueve"sv}) {
+        EXPECT_EQ(table.get_all_pos(key), n.get_all_pos(key));
+        EXPECT_EQ(table.get_all_values(key), n.get_all_values(key));
+        EXPECT_EQ(table.count(key), n.count(key));
+    }
+    EXPECT_EQ(table.get_pos("Dos", 2, 5), std::vector<size_t>({4, 7}));
+    EXPECT_EQ(table.get_value(8), 8);
+    EXPECT_EQ(table.get_at(9), table.end());
+    EXPECT_EQ(table.get_key_at(9), "");
+
+    // Heterogeneous keys hash as their characters.
+    const std::string key = "Seis";
+    EXPECT_EQ(table.find(key)->second, 6);
+    EXPECT_EQ(table.find("Seis")->second, 6);
+}
+
+TEST(VectorMapTestStatic, Collisions) {
+    // Every key shares the slot chain with others: a full table of small integers with repeated keys.
+    constexpr auto make = [] {
+        std::pair<uint64_t, uint64_t> elems[256];
+        for (uint64_t i = 0; i < 256; ++i) {
+            elems[i] = {(i * 37) % 100, i};
+        }
+        return com::static_vectormap<uint64_t, uint64_t, 256>(elems);
+    };
+    constexpr auto big = make();
+    static_assert(big.count(37) == 3);
+
+    com::vectormap<uint64_t, uint64_t> v;
+    for (const auto& elem : big) {
+        v.push_back(elem);
+    }
+    for (uint64_t key = 0; key < 110; ++key) {
+        EXPECT_EQ(big.get_all_pos(key), v.get_all_pos(key));
+        EXPECT_EQ(big.find_nth(key, 2), big.get_at(v.get_pos(key, 2).empty() ? big.npos : v.get_pos(key, 2).at(0)));
+    }
+}
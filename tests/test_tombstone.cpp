@@ -0,0 +1,161 @@
+#include "tombstone_vectormap.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+using vmap = com::vectormap<std::string, size_t, 3>;
+using tmap = com::tombstone_vectormap<std::string, size_t, 3>;
+
+class VectorMapTestTombstone : public ::testing::Test {
+    protected:
+        vmap n = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+        tmap m = {{"Cero", 0}, {"Uno", 1}, {"Dos", 2}, {"Tres", 3}, {"Dos", 4}, {"Cinco", 5}, {"Seis", 6}, {"Dos", 7}, {"Ocho", 8}};
+
+        void expect_same_elements() {
+            ASSERT_EQ(m.size(), n.size());
+            size_t i = 0;
+            for (const auto& elem : m) {
+                EXPECT_EQ(elem, n[i]);
+                EXPECT_EQ(m[i], n[i]);
+                EXPECT_EQ(m.get_key(i), n.get_key(i));
+                ++i;
+            }
+            EXPECT_EQ(i, n.size());
+        }
+};
+
+TEST_F(VectorMapTestTombstone, LazyErase) {
+    m.compaction_ratio(1);
+    n.erase(0);
+    m.erase(0);
+    n.erase("Dos");
+    m.erase("Dos");
+    n.erase(3);
+    m.erase(3);
+    EXPECT_EQ(m.tombstones(), 3);
+    EXPECT_EQ(m.storage().size(), 9);
+    expect_same_elements();
+
+    EXPECT_EQ(m.get_all_pos("Dos"), n.get_all_pos("Dos"));
+    EXPECT_EQ(m.get_all_values("Dos"), std::vector<size_t>({4, 7}));
+    EXPECT_EQ(m.get_value("Dos", 2).at(0), 7);
+    EXPECT_EQ(m.count("Dos"), 2);
+    EXPECT_FALSE(m.contains("Cero"));
+    EXPECT_EQ(m.find("Cinco"), m.end());
+    EXPECT_EQ(m.find_nth("Dos", 2)->second, 7);
+    EXPECT_EQ(m.get(0)->first, "Uno");
+    EXPECT_EQ(m.get_at(6), m.end());
+    EXPECT_EQ(m.get_value(5), 8);
+
+    EXPECT_EQ(m.erase_all("Dos"), 2);
+    n.erase_all("Dos");
+    expect_same_elements();
+
+    EXPECT_EQ(m.compact(), 5);
+    EXPECT_EQ(m.tombstones(), 0);
+    EXPECT_EQ(m.storage().size(), 4);
+    expect_same_elements();
+}
+
+TEST_F(VectorMapTestTombstone, Insertion) {
+    m.erase(1);
+    n.erase(1);
+    m.push_back("Nueve", 9);
+    n.push_back("Nueve", 9);
+    m.emplace_back("Diez", 10);
+    n.emplace_back("Diez", 10);
+    EXPECT_EQ(m.tombstones(), 1);
+    expect_same_elements();
+
+    m.insert({"Once", 11}, 2);
+    n.insert({"Once", 11}, 2);
+    EXPECT_EQ(m.tombstones(), 0);
+    expect_same_elements();
+    EXPECT_EQ(m.insert({"Doce", 12}, 20), m.end());
+
+    m.set_value(20, "Dos", 2);
+    n.set_value(20, "Dos", 2);
+    m.set_value_at(21, 0);
+    n.set_value_at(21, 0);
+    m.set_key_at("Veinte", 1);
+    n.set_key_at("Veinte", 1);
+    expect_same_elements();
+
+    tmap::iterator it = m.end();
+    EXPECT_EQ((--it)->first, "Diez");
+    EXPECT_EQ((--it)->first, "Nueve");
+
+    m.clear();
+    EXPECT_TRUE(m.is_empty());
+    EXPECT_EQ(m.begin(), m.end());
+}
+
+TEST_F(VectorMapTestTombstone, AutomaticCompaction) {
+    EXPECT_EQ(m.compaction_ratio(), 0.5);
+    for (size_t i = 0; i < 4; ++i) {
+        m.erase(0);
+    }
+    EXPECT_EQ(m.tombstones(), 4);
+    m.erase(0);
+    EXPECT_EQ(m.tombstones(), 0);
+    EXPECT_EQ(m.size(), 4);
+    EXPECT_EQ(m.get_key_at(0), "Cinco");
+}
+
+TEST_F(VectorMapTestTombstone, Fifo) {
+    com::tombstone_vectormap<uint64_t, uint64_t> q;
+    std::deque<std::pair<uint64_t, uint64_t>> ref;
+    std::mt19937_64 gen(7);
+
+    for (uint64_t i = 0; i < 5000; ++i) {
+        q.push_back(i % 97, i);
+        ref.emplace_back(i % 97, i);
+        if (gen() % 3 != 0) {
+            q.erase_at(0);
+            ref.pop_front();
+        }
+        if (i % 500 == 0) {
+            size_t pos = gen() % ref.size();
+            q.erase_at(pos);
+            ref.erase(ref.begin() + static_cast<std::ptrdiff_t>(pos));
+        }
+    }
+
+    ASSERT_EQ(q.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); i += 37) {
+        EXPECT_EQ(q.get_key_at(i), ref[i].first);
+        EXPECT_EQ(q[i].second, ref[i].second);
+    }
+
+    std::vector<size_t> pos;
+    for (size_t i = 0; i < ref.size(); ++i) {
+        if (ref[i].first == 5) {
+            pos.push_back(i);
+        }
+    }
+    EXPECT_EQ(q.get_all_pos(5), pos);
+    EXPECT_LE(q.tombstones(), q.storage().size() / 2);
+}
+
+TEST_F(VectorMapTestTombstone, OutOfRange) {
+    m.erase_at(1);
+    n.erase_at(1);
+    m.erase_at(4);
+    n.erase_at(4);
+
+    // Positions past the live elements are ignored, as by vectormap, even though dead slots remain behind them.
+    for (size_t pos : {n.size(), n.size() + 1, size_t(100)}) {
+        m.set_value_at(99, pos);
+        n.set_value_at(99, pos);
+        m.set_key_at("Nueve", pos);
+        n.set_key_at("Nueve", pos);
+    }
+    expect_same_elements();
+    EXPECT_FALSE(m.contains("Nueve"));
+    EXPECT_EQ(m.get_at(n.size()), m.end());
+    EXPECT_EQ(m.get_value_at(n.size()), 0);
+}